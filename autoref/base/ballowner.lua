@@ -1,3 +1,4 @@
+local Cache = require "base/cache"
 local World = require "base/world"
 
 local BallOwner = {}
@@ -7,34 +8,35 @@ local BallOwner = {}
 -- dist is the length of the semi-minor axis
 -- @param robot robot - the robot to calculate
 -- @param ballPos vector - position of the ball
-local function ellipticDistance(robot, ballPos)
-	local dribblerPos = robot.pos + Vector.fromAngle(robot.dir):scaleLength(robot.shootRadius)
-	local dribblerWidthHalf = Vector.fromAngle(robot.dir - math.pi/2):scaleLength(robot.dribblerWidth/2)
-	local leftDribblerEdge = dribblerPos + dribblerWidthHalf
-	local rightDribblerEdge = dribblerPos - dribblerWidthHalf
-	return 0.5*math.sqrt((leftDribblerEdge:distanceTo(ballPos) + rightDribblerEdge:distanceTo(ballPos))^2 - robot.dribblerWidth*robot.dribblerWidth)
-end
+local ellipticDistance = Cache.forFrame(function(robot, ballPos)
+	-- computed on plain numbers as this runs for every robot in every frame
+	local dirX, dirY = math.cos(robot.dir), math.sin(robot.dir)
+	local dribblerX = robot.pos.x + dirX * robot.shootRadius - ballPos.x
+	local dribblerY = robot.pos.y + dirY * robot.shootRadius - ballPos.y
+	-- points to the right of the robot
+	local halfWidthX = dirY * robot.dribblerWidth / 2
+	local halfWidthY = -dirX * robot.dribblerWidth / 2
+	local leftDist = math.sqrt((dribblerX + halfWidthX)^2 + (dribblerY + halfWidthY)^2)
+	local rightDist = math.sqrt((dribblerX - halfWidthX)^2 + (dribblerY - halfWidthY)^2)
+	return 0.5*math.sqrt((leftDist + rightDist)^2 - robot.dribblerWidth*robot.dribblerWidth)
+end, "ball owner distance")
 
 --- Returns the ball owner or nil if no robot is on the field
 -- @return ballOwner robot - the robot that can be seen as ball owner, or nil
 local BALL_OWN_HYSTERESIS = 0.03
 local lastBallOwner = nil
-local lastCall = 0
-function BallOwner.lastRobot()
-	if lastCall and lastCall == World.Time then -- cached result
-		return lastBallOwner
-	else
-		lastCall = World.Time
-	end
-
+BallOwner.lastRobot = Cache.forFrame(function()
 	-- search robot with min dist to ball
 	local minDist = math.huge
 	local ballOwner = nil
 	for _, r in ipairs(World.Robots) do
-		local dist = ellipticDistance(r, World.Ball.pos)
-		if dist < minDist then
-			minDist = dist
-			ballOwner = r
+		-- the elliptic distance is at most shootRadius + dribblerWidth smaller than the center distance
+		if World.Distances:ballDistance(r) - r.shootRadius - r.dribblerWidth <= minDist then
+			local dist = ellipticDistance(r, World.Ball.pos)
+			if dist < minDist then
+				minDist = dist
+				ballOwner = r
+			end
 		end
 	end
 
@@ -50,6 +52,6 @@ function BallOwner.lastRobot()
 	end
 
 	return lastBallOwner
-end
+end, "ball owner")
 
 return BallOwner
@@ -32,6 +32,8 @@ module "base"
 *************************************************************************]]
 
 require "base/amun"
+-- skip parsing unchanged modules, this must be installed before loading any further modules
+require("base/bytecodecache").install()
 local debugger = require "base/debugger" -- preload debugger to allow triggering it later
 if math.mod ~= nil then
 	log("Warning: Using LuaJIT without lua 5.2 compatibility mode. Strategy behaviour on replay may be unstable")
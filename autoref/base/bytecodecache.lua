@@ -0,0 +1,171 @@
+--[[
+--- Caches the LuaJIT bytecode of required modules.
+-- Once installed, modules found on the package path are loaded from the cache if their source did not
+-- change, which skips parsing them. The cache is stored in a single file in the strategy directory,
+-- which is replaced by BytecodeCache.save if modules had to be parsed.
+module "BytecodeCache"
+]]--
+
+--[[***********************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+*************************************************************************]]
+
+
+local BytecodeCache = {}
+
+local ffi = require "ffi"
+local bit = require "bit"
+local jit = require "jit"
+require "base/amun"
+
+local CACHE_FILENAME = ".bytecode-cache"
+-- the bytecode depends on the LuaJIT version, the architecture and the GC64 mode
+local FORMAT_HEADER = "autoref bytecode cache 2 " .. jit.version .. " " .. jit.arch ..
+	(ffi.abi("gc64") and " gc64" or "") .. "\n"
+
+local cachePath = nil
+-- hash .. " " .. name -> bytecode
+local cachedEntries = {}
+-- entries used by this run, written by save
+local usedEntries = {}
+local isModified = false
+local stats = { cached = 0, parsed = 0 }
+
+-- 64 bit FNV-1a hash of the file content, jit compiled this is much faster than parsing
+local function hash(content)
+	local bytes = ffi.cast("const uint8_t*", content)
+	local h = 14695981039346656037ULL
+	for i = 0, #content - 1 do
+		h = bit.bxor(h, bytes[i]) * 1099511628211ULL
+	end
+	return bit.tohex(h) .. string.format("%x", #content)
+end
+
+local function readFile(filename)
+	local file = io.open(filename, "rb")
+	if not file then
+		return nil
+	end
+	local content = file:read("*a")
+	file:close()
+	return content
+end
+
+local function loadCache()
+	local content = readFile(cachePath)
+	if not content or content:sub(1, #FORMAT_HEADER) ~= FORMAT_HEADER then
+		return
+	end
+	local pos = #FORMAT_HEADER + 1
+	while pos <= #content do
+		local lineEnd = content:find("\n", pos, true)
+		if not lineEnd then
+			break
+		end
+		local key, length = content:sub(pos, lineEnd - 1):match("^(.+) (%d+)$")
+		length = tonumber(length)
+		if not key or lineEnd + length > #content then
+			-- truncated file, keep the complete entries
+			break
+		end
+		cachedEntries[key] = content:sub(lineEnd + 1, lineEnd + length)
+		pos = lineEnd + length + 1
+	end
+end
+
+local function loader(name)
+	local filename = package.searchpath(name, package.path)
+	if not filename then
+		return nil
+	end
+	local source = readFile(filename)
+	if not source then
+		return nil
+	end
+
+	local key = hash(source) .. " " .. name
+	local bytecode = cachedEntries[key]
+	if bytecode then
+		local chunk = loadstring(bytecode, "@" .. filename)
+		if chunk then
+			usedEntries[key] = bytecode
+			stats.cached = stats.cached + 1
+			return chunk
+		end
+	end
+
+	local chunk, err = loadstring(source, "@" .. filename)
+	if not chunk then
+		error(err, 0)
+	end
+	usedEntries[key] = string.dump(chunk)
+	isModified = true
+	stats.parsed = stats.parsed + 1
+	return chunk
+end
+
+--- Loads the cache and adds its loader in front of the file loaders
+-- Does nothing if the io library or package.searchpath is not available
+-- @name install
+function BytecodeCache.install()
+	if cachePath or not io or not package.searchpath then
+		return
+	end
+	local strategyPath = amun.strategyPath or amun.getStrategyPath()
+	cachePath = strategyPath .. "/" .. CACHE_FILENAME
+	loadCache()
+	-- the first loader handles package.preload
+	table.insert(package.loaders, 2, loader)
+end
+
+--- Writes the bytecode of the modules loaded so far if any of them had to be parsed
+-- Entries of modules that were not loaded are dropped. The cache is written to a temporary
+-- file which then replaces the old one, thus other instances never read a partial cache.
+-- @name save
+function BytecodeCache.save()
+	if not cachePath or not isModified or not os then
+		return
+	end
+	isModified = false
+	-- unique for every instance, several autorefs may share the strategy directory
+	local tmpPath = string.format("%s.%.0f-%s.tmp", cachePath, amun.getCurrentTime(), tostring({}):match("%x+$"))
+	local file = io.open(tmpPath, "wb")
+	if not file then
+		return
+	end
+	local parts = { FORMAT_HEADER }
+	for key, bytecode in pairs(usedEntries) do
+		table.insert(parts, key .. " " .. #bytecode .. "\n")
+		table.insert(parts, bytecode)
+	end
+	local written = file:write(table.concat(parts))
+	local closed = file:close()
+	if not written or not closed or not os.rename(tmpPath, cachePath) then
+		os.remove(tmpPath)
+	end
+end
+
+--- Returns the number of modules loaded from the cache and from source
+-- @name stats
+-- @return cached number
+-- @return parsed number
+function BytecodeCache.stats()
+	return stats.cached, stats.parsed
+end
+
+return BytecodeCache
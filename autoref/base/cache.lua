@@ -25,91 +25,234 @@ module "Cache"
 
 local Cache = {}
 
-local cleanup = {}
+local debug = require "base/debug"
+
+local select, unpack = select, unpack
+
+-- frame caches with more entries than this are replaced on resetFrame,
+-- as entries for keys that aren't used anymore are never overwritten
+local MAX_FRAME_ENTRIES = 512
+
+local caches = {}
+local statistics = {}
+local statisticsList = {}
+local generation = 0
 local nilObj = {}
 
-local function getFromCache(cached, params)
-	local pcount = table.maxn(params)
-	params[0] = pcount
+local function weakTable()
+	return setmetatable({}, {__mode = "k"})
+end
 
-	local entry = cached
-	for i = 0, pcount do
-		local param = params[i]
-		if param == nil then
-			param = nilObj
-		end
-		entry = entry[param]
-		if entry == nil then
-			return nil
-		end
+local function getStatistics(name)
+	name = name or "unnamed"
+	local stats = statistics[name]
+	if not stats then
+		stats = {name = name, hits = 0, misses = 0}
+		statistics[name] = stats
+		table.insert(statisticsList, stats)
 	end
-	return entry
+	return stats
 end
 
-local function setInCache(cached, params, result)
-	local pcount = table.maxn(params)
-	params[0] = pcount
+-- the results are stored in the entry itself, so that a stale entry
+-- is reused for the next frame instead of allocating a new one
+local function storeResult(cache, entry, ...)
+	local n = select("#", ...)
+	for i = 1, n do
+		entry[i] = (select(i, ...))
+	end
+	for i = n + 1, entry.n do
+		entry[i] = nil
+	end
+	entry.n = n
+	entry.generation = generation
+	cache.stats.misses = cache.stats.misses + 1
+	return ...
+end
 
-	local entry = cached
-	for i = 0, pcount do
-		local param = params[i]
-		-- nil can't be used as array index
-		if param == nil then
-			param = nilObj
-		end
-		if i == pcount then
-			entry[param] = result
-			return
-		elseif entry[param] == nil then
-			local newEntry = {}
-			setmetatable(newEntry, {__mode = "k"})
-			entry[param] = newEntry
-		end
-		entry = entry[param]
+local function isValid(cache, entry)
+	return entry ~= nil and (cache.keepForever or entry.generation == generation)
+end
+
+local function newEntry(cache)
+	cache.entries = cache.entries + 1
+	return {n = 0, generation = -1}
+end
+
+local function hit(cache, entry)
+	cache.stats.hits = cache.stats.hits + 1
+	return unpack(entry, 1, entry.n)
+end
+
+-- nil can't be used as table index
+local function key(param)
+	if param == nil then
+		return nilObj
+	end
+	return param
+end
+
+local function subTable(map, param)
+	local sub = map[param]
+	if sub == nil then
+		sub = weakTable()
+		map[param] = sub
+	end
+	return sub
+end
+
+local function call0(cache, f)
+	local entry = cache.entry0
+	if isValid(cache, entry) then
+		return hit(cache, entry)
+	end
+	if entry == nil then
+		entry = newEntry(cache)
+		cache.entry0 = entry
 	end
+	return storeResult(cache, entry, f())
 end
 
-local function makeCached(f, keepForever)
-	local cached = {}
+local function call1(cache, f, a)
+	local map = cache.map1
+	local ka = key(a)
+	local entry = map[ka]
+	if isValid(cache, entry) then
+		return hit(cache, entry)
+	end
+	if entry == nil then
+		entry = newEntry(cache)
+		map[ka] = entry
+	end
+	return storeResult(cache, entry, f(a))
+end
+
+local function call2(cache, f, a, b)
+	local map = subTable(cache.map2, key(a))
+	local kb = key(b)
+	local entry = map[kb]
+	if isValid(cache, entry) then
+		return hit(cache, entry)
+	end
+	if entry == nil then
+		entry = newEntry(cache)
+		map[kb] = entry
+	end
+	return storeResult(cache, entry, f(a, b))
+end
+
+local function call3(cache, f, a, b, c)
+	local map = subTable(subTable(cache.map3, key(a)), key(b))
+	local kc = key(c)
+	local entry = map[kc]
+	if isValid(cache, entry) then
+		return hit(cache, entry)
+	end
+	if entry == nil then
+		entry = newEntry(cache)
+		map[kc] = entry
+	end
+	return storeResult(cache, entry, f(a, b, c))
+end
+
+-- fallback for more than three parameters, walks one table level per parameter
+local function callN(cache, f, pcount, ...)
+	local map = subTable(cache.mapN, pcount)
+	for i = 1, pcount - 1 do
+		map = subTable(map, key((select(i, ...))))
+	end
+	local kn = key((select(pcount, ...)))
+	local entry = map[kn]
+	if isValid(cache, entry) then
+		return hit(cache, entry)
+	end
+	if entry == nil then
+		entry = newEntry(cache)
+		map[kn] = entry
+	end
+	return storeResult(cache, entry, f(...))
+end
+
+local function clear(cache)
+	cache.entry0 = nil
+	cache.map1 = weakTable()
+	cache.map2 = weakTable()
+	cache.map3 = weakTable()
+	cache.mapN = weakTable()
+	cache.entries = 0
+end
+
+local function makeCached(f, keepForever, name)
+	local cache = {keepForever = keepForever, stats = getStatistics(name)}
+	clear(cache)
 	if not keepForever then
-		table.insert(cleanup,
-			function()
-				cached = {}
-			end
-		)
+		table.insert(caches, cache)
 	end
+	-- dispatch by the number of parameters to avoid packing them into tables
 	return function(...)
-		local result = getFromCache(cached, {...})
-		if not result then
-			result = { f(...) }
-			setInCache(cached, {...}, result)
+		local pcount = select("#", ...)
+		if pcount == 1 then
+			return call1(cache, f, ...)
+		elseif pcount == 2 then
+			return call2(cache, f, ...)
+		elseif pcount == 0 then
+			return call0(cache, f)
+		elseif pcount == 3 then
+			return call3(cache, f, ...)
+		else
+			return callN(cache, f, pcount, ...)
 		end
-		return unpack(result)
 	end
 end
 
 --- Wraps a function call, the returned value is cached for this strategy run
 -- @name forFrame
 -- @param f function - function to wrap
+-- @param [name string - name to report the cache hits and misses with]
 -- @return function - wrapped function
-function Cache.forFrame(f)
-	return makeCached(f, false)
+function Cache.forFrame(f, name)
+	return makeCached(f, false, name)
 end
 
 --- Wraps a function call, the returned value is cached until the strategy is reloaded
 -- @name forever
 -- @param f function - function to wrap
+-- @param [name string - name to report the cache hits and misses with]
 -- @return function - wrapped function
-function Cache.forever(f)
-	return makeCached(f, true)
+function Cache.forever(f, name)
+	return makeCached(f, true, name)
 end
 
---- Clears the value cache for the current frame
+--- Clears the value cache for the current frame.
+-- Entries of the last frame are invalidated by a generation counter
+-- and reused once the same parameters are passed again
 -- @name resetFrame
 function Cache.resetFrame()
-	for i = 1, #cleanup do
-		cleanup[i]()
+	generation = generation + 1
+	for i = 1, #caches do
+		local cache = caches[i]
+		if cache.entries > MAX_FRAME_ENTRIES then
+			clear(cache)
+		end
+	end
+end
+
+--- Publishes the cache hits and misses of every wrapped function since the last report
+-- @name report
+function Cache.report()
+	if #statisticsList == 0 then
+		return
+	end
+	debug.pushtop("Cache")
+	for _, stats in ipairs(statisticsList) do
+		debug.push(stats.name)
+		debug.set("hits", stats.hits)
+		debug.set("misses", stats.misses)
+		debug.pop()
+		stats.hits = 0
+		stats.misses = 0
 	end
+	debug.pop()
 end
 
 return Cache
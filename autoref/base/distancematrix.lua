@@ -0,0 +1,344 @@
+--[[
+--- Distances and relative speeds between all robots and the ball
+module "DistanceMatrix"
+]]--
+
+--[[***********************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+*************************************************************************]]
+
+
+local DistanceMatrix = (require "base/class")("DistanceMatrix")
+
+local ffi = require "ffi"
+
+local BALL = 0
+-- objects are not swept across longer gaps, e.g. after vision was lost
+local MAX_SWEEP_INTERVAL = 0.1 -- s
+
+--- Values provided by DistanceMatrix
+-- The matrix is filled once per frame by the world. Every query only reads
+-- from preallocated arrays and returns plain numbers, thus rules can query
+-- it for every pair of robots without creating garbage.
+-- Index 0 is the ball, the robots follow in the order of World.Robots.
+-- The positions and speeds of the previous frame are kept to sweep the
+-- robots along their path between both frames.
+-- @class table
+-- @name DistanceMatrix
+
+local function newFrame()
+	return {
+		count = 0,
+		capacity = -1,
+		time = nil,
+		robots = {},
+		indexOf = {}
+	}
+end
+
+local function reserveFrame(frame, count)
+	if count <= frame.capacity then
+		return
+	end
+	local size = count + 1
+	frame.capacity = count
+	frame.posX = ffi.new("double[?]", size)
+	frame.posY = ffi.new("double[?]", size)
+	frame.velX = ffi.new("double[?]", size)
+	frame.velY = ffi.new("double[?]", size)
+	frame.speed = ffi.new("double[?]", size)
+	-- index of the same object in the previous frame or -1
+	frame.previous = ffi.new("int[?]", size)
+end
+
+--- Initializes an empty matrix, must only be called by world!
+function DistanceMatrix:init()
+	self._frame = newFrame()
+	self._previousFrame = newFrame()
+	self._capacity = -1
+	self._ball = nil
+	self:_reserve(24)
+end
+
+function DistanceMatrix:_reserve(count)
+	reserveFrame(self._frame, count)
+	if count <= self._capacity then
+		return
+	end
+	local size = count + 1
+	self._capacity = count
+	-- row-major matrices of size (count + 1)^2
+	self._dist = ffi.new("double[?]", size * size)
+	self._closing = ffi.new("double[?]", size * size)
+	self._stride = size
+end
+
+--- Recomputes the matrix, must only be called by world!
+-- @param robots Robot[] - all visible robots
+-- @param ball Ball - the ball
+-- @param time number - time of the world state
+function DistanceMatrix:_update(robots, ball, time)
+	-- reuse the arrays of the frame before the previous one
+	local frame = self._previousFrame
+	self._previousFrame = self._frame
+	self._frame = frame
+	local previousTime = self._previousFrame.time
+	local previousIndexOf = self._previousFrame.indexOf
+	local canSweep = previousTime ~= nil and time - previousTime <= MAX_SWEEP_INTERVAL
+
+	local robotList = frame.robots
+	local indexOf = frame.indexOf
+	for i = 1, frame.count do
+		indexOf[robotList[i]] = nil
+		robotList[i] = nil
+	end
+
+	local count = #robots
+	self:_reserve(count)
+	frame.count = count
+	frame.time = time
+
+	self._ball = ball
+	local posX, posY, velX, velY, speed = frame.posX, frame.posY, frame.velX, frame.velY, frame.speed
+	posX[BALL], posY[BALL] = ball.pos.x, ball.pos.y
+	velX[BALL], velY[BALL] = ball.speed.x, ball.speed.y
+	speed[BALL] = ball.speed:length()
+	frame.previous[BALL] = canSweep and BALL or -1
+	for i = 1, count do
+		local robot = robots[i]
+		robotList[i] = robot
+		indexOf[robot] = i
+		posX[i], posY[i] = robot.pos.x, robot.pos.y
+		velX[i], velY[i] = robot.speed.x, robot.speed.y
+		speed[i] = robot.speed:length()
+		frame.previous[i] = canSweep and previousIndexOf[robot] or -1
+	end
+
+	local dist, closing, stride = self._dist, self._closing, self._stride
+	for i = 0, count do
+		dist[i * stride + i] = 0
+		closing[i * stride + i] = 0
+		for j = i + 1, count do
+			local dx, dy = posX[j] - posX[i], posY[j] - posY[i]
+			local d = math.sqrt(dx * dx + dy * dy)
+			-- speed with which i and j approach each other along their connecting line
+			local c = 0
+			if d > 0 then
+				c = ((velX[i] - velX[j]) * dx + (velY[i] - velY[j]) * dy) / d
+			end
+			dist[i * stride + j], dist[j * stride + i] = d, d
+			closing[i * stride + j], closing[j * stride + i] = c, c
+		end
+	end
+end
+
+--- Returns the number of robots in the matrix
+-- @name count
+-- @return number
+function DistanceMatrix:count()
+	return self._frame.count
+end
+
+--- Returns the robot at the given index
+-- @name robot
+-- @param index number - 1 to count()
+-- @return Robot
+function DistanceMatrix:robot(index)
+	return self._frame.robots[index]
+end
+
+--- Returns the index of a robot or the ball
+-- @name indexOf
+-- @param object Robot|Ball - object that was visible in the current frame
+-- @return number - index or nil if the robot is not visible
+function DistanceMatrix:indexOf(object)
+	if object == self._ball then
+		return BALL
+	end
+	return self._frame.indexOf[object]
+end
+
+--- Returns the distance between the centers of two objects by index
+-- @name distanceByIndex
+-- @param i number - index of the first object, 0 is the ball
+-- @param j number - index of the second object
+-- @return number
+function DistanceMatrix:distanceByIndex(i, j)
+	return self._dist[i * self._stride + j]
+end
+
+--- Returns the speed with which two objects approach each other by index
+-- The speed is measured along the line connecting both centers, it is
+-- negative if they move apart.
+-- @name closingSpeedByIndex
+-- @param i number - index of the first object, 0 is the ball
+-- @param j number - index of the second object
+-- @return number
+function DistanceMatrix:closingSpeedByIndex(i, j)
+	return self._closing[i * self._stride + j]
+end
+
+--- Returns the absolute speed of an object by index
+-- @name speedByIndex
+-- @param i number - index of the object, 0 is the ball
+-- @return number
+function DistanceMatrix:speedByIndex(i)
+	return self._frame.speed[i]
+end
+
+--- Returns the distance between the centers of two robots or a robot and the ball
+-- @name distance
+-- @param a Robot|Ball
+-- @param b Robot|Ball
+-- @return number
+function DistanceMatrix:distance(a, b)
+	return self._dist[self:indexOf(a) * self._stride + self:indexOf(b)]
+end
+
+--- Returns the speed with which two robots or a robot and the ball approach each other
+-- @name closingSpeed
+-- @param a Robot|Ball
+-- @param b Robot|Ball
+-- @return number - negative if they move apart
+function DistanceMatrix:closingSpeed(a, b)
+	return self._closing[self:indexOf(a) * self._stride + self:indexOf(b)]
+end
+
+--- Returns the distance between the centers of a robot and the ball
+-- @name ballDistance
+-- @param robot Robot
+-- @return number
+function DistanceMatrix:ballDistance(robot)
+	return self._dist[self._frame.indexOf[robot]]
+end
+
+--- Returns the first robot whose center is within the given distance to the ball
+-- @name firstRobotNearBall
+-- @param maxDist number
+-- @return Robot - or nil if there is none
+function DistanceMatrix:firstRobotNearBall(maxDist)
+	local dist = self._dist
+	for i = 1, self._frame.count do
+		if dist[i] <= maxDist then
+			return self._frame.robots[i]
+		end
+	end
+	return nil
+end
+
+-- contact at the current frame, with the velocities of the current frame
+local function currentContact(self, i, j, contactDistance)
+	local frame = self._frame
+	if self._dist[i * self._stride + j] > contactDistance then
+		return nil
+	end
+	return frame.time, self._closing[i * self._stride + j], frame.speed[i], frame.speed[j], 1
+end
+
+--- Finds the first contact of two objects since the previous frame
+-- Both objects are swept as circles along a straight line from their
+-- previous to their current position, thus contacts between two frames are
+-- found as well. The velocities at the time of impact are interpolated
+-- between the tracked velocities of both frames. Objects that were not
+-- visible in the previous frame or that already touched in the previous frame
+-- are only checked at their current position.
+-- @name sweptContactByIndex
+-- @param i number - index of the first object, 0 is the ball
+-- @param j number - index of the second object
+-- @param contactDistance number - distance between both centers at contact
+-- @return number - time of impact or nil if there is no contact
+-- @return number - speed with which i hits j along the contact normal
+-- @return number - absolute speed of i at the time of impact
+-- @return number - absolute speed of j at the time of impact
+-- @return number - fraction of the time between the previous and the current frame
+function DistanceMatrix:sweptContactByIndex(i, j, contactDistance)
+	local frame, previousFrame = self._frame, self._previousFrame
+	local pi, pj = frame.previous[i], frame.previous[j]
+	if pi < 0 or pj < 0 then
+		return currentContact(self, i, j, contactDistance)
+	end
+
+	-- relative position of j at the previous frame and its displacement until now
+	local startX = previousFrame.posX[pj] - previousFrame.posX[pi]
+	local startY = previousFrame.posY[pj] - previousFrame.posY[pi]
+	local moveX = frame.posX[j] - frame.posX[i] - startX
+	local moveY = frame.posY[j] - frame.posY[i] - startY
+
+	-- smallest s in [0, 1] with |start + s * move| = contactDistance
+	local c = startX * startX + startY * startY - contactDistance * contactDistance
+	if c <= 0 then
+		-- the contact started before the previous frame, it only continues if
+		-- both still touch, thus the previous velocities must not be reported
+		return currentContact(self, i, j, contactDistance)
+	end
+	local a = moveX * moveX + moveY * moveY
+	local b = 2 * (startX * moveX + startY * moveY)
+	local discriminant = b * b - 4 * a * c
+	if a == 0 or discriminant < 0 then
+		return nil
+	end
+	local s = (-b - math.sqrt(discriminant)) / (2 * a)
+	if s < 0 or s > 1 then
+		return nil
+	end
+
+	local normalX, normalY = startX + s * moveX, startY + s * moveY
+	local normalLength = math.sqrt(normalX * normalX + normalY * normalY)
+	local viX, viY = self:velocityAt(i, s)
+	local vjX, vjY = self:velocityAt(j, s)
+	local impactSpeed = 0
+	if normalLength > 0 then
+		impactSpeed = ((viX - vjX) * normalX + (viY - vjY) * normalY) / normalLength
+	end
+	local time = previousFrame.time + s * (frame.time - previousFrame.time)
+	return time, impactSpeed, math.sqrt(viX * viX + viY * viY), math.sqrt(vjX * vjX + vjY * vjY), s
+end
+
+--- Returns the position of an object between the previous and the current frame
+-- @name positionAt
+-- @param i number - index of the object, 0 is the ball
+-- @param s number - fraction of the time between both frames as returned by sweptContactByIndex
+-- @return number - x coordinate
+-- @return number - y coordinate
+function DistanceMatrix:positionAt(i, s)
+	local frame, previousFrame = self._frame, self._previousFrame
+	local p = frame.previous[i]
+	if p < 0 then
+		return frame.posX[i], frame.posY[i]
+	end
+	return previousFrame.posX[p] + s * (frame.posX[i] - previousFrame.posX[p]),
+		previousFrame.posY[p] + s * (frame.posY[i] - previousFrame.posY[p])
+end
+
+--- Returns the velocity of an object between the previous and the current frame
+-- @name velocityAt
+-- @param i number - index of the object, 0 is the ball
+-- @param s number - fraction of the time between both frames as returned by sweptContactByIndex
+-- @return number - x component
+-- @return number - y component
+function DistanceMatrix:velocityAt(i, s)
+	local frame, previousFrame = self._frame, self._previousFrame
+	local p = frame.previous[i]
+	if p < 0 then
+		return frame.velX[i], frame.velY[i]
+	end
+	return previousFrame.velX[p] + s * (frame.velX[i] - previousFrame.velX[p]),
+		previousFrame.velY[p] + s * (frame.velY[i] - previousFrame.velY[p])
+end
+
+return DistanceMatrix
@@ -133,11 +133,6 @@ function Field.limitToField(pos, boundaryWidthTouchLine, boundaryWidthGoalLine)
 	return Vector(x, y)
 end
 
---- returns the nearest position inside the field without defense areas
--- @name limitToAllowedField
--- @param extraLimit number - how much the field should be additionally limited
--- @param pos Vector - the position to limit
--- @return Vector - limited vector
 local function limitToAllowedField_2017(pos, extraLimit)
 	extraLimit = extraLimit or 0
 	local oppExtraLimit = extraLimit
@@ -237,59 +232,46 @@ function Field.distanceToFieldBorder(pos, boundaryWidth)
 	return math.bound(0, dx, dy)
 end
 
-local function distanceToDefenseAreaSq_2018(pos, friendly)
-	local defenseMin = Vector(-G.DefenseWidthHalf,G.FieldHeightHalf-G.DefenseHeight)
-	local defenseMax = Vector(G.DefenseWidthHalf,G.FieldHeightHalf)
-	if friendly then
-		defenseMin, defenseMax = -defenseMax, -defenseMin
-	end
-	return pos:distanceToSq(geom.boundRect(defenseMin, pos, defenseMax))
-end
-
-local function isInDefenseArea_2018(pos, radius, friendly)
-	if radius < 0 then
-		local defenseMin = Vector(-G.DefenseWidthHalf-radius, G.FieldHeightHalf-G.DefenseHeight-radius)
-		local defenseMax = Vector(G.DefenseWidthHalf+radius, G.FieldHeightHalf+radius)
-		if friendly then
-			defenseMin, defenseMax = -defenseMax, -defenseMin
-		end
-		if defenseMin.x > defenseMax.x or defenseMin.y > defenseMax.y then
-			return false
-		end
-		return geom.insideRect(defenseMin, defenseMax, pos)
-	end
-	return distanceToDefenseAreaSq_2018(pos, friendly) <= radius * radius
-end
-
-local function distanceToDefenseArea_2018(pos, radius, friendly)
-	local defenseMin = Vector(-G.DefenseWidthHalf,G.FieldHeightHalf-G.DefenseHeight)
-	local defenseMax = Vector(G.DefenseWidthHalf,G.FieldHeightHalf)
+--- Returns the signed distance of a position to the defense area
+-- The shape of the area is taken from the geometry, thus this works for
+-- every rule version without further checks.
+-- @name signedDistanceToDefenseArea
+-- @param x number - x coordinate of the position
+-- @param y number - y coordinate of the position
+-- @param friendly bool - selection of Own/Opponent area
+-- @return number - distance to the border of the area, negative inside
+function Field.signedDistanceToDefenseArea(x, y, friendly)
+	local area = friendly and G.YellowDefenseArea or G.BlueDefenseArea
+	local dx = math.abs(x - area.centerX) - area.halfWidth
+	local dy = math.abs(y - area.centerY) - area.halfHeight
 	local distance
-	if friendly then
-		pos = -pos
-	end
-	if radius < 0 and isInDefenseArea_2018(pos, 0) then
-		local min = defenseMax.x-pos.x
-		min = math.min(min, pos.x-defenseMin.x)
-		min = math.min(min, defenseMax.y-pos.y)
-		min = math.min(min, pos.y-defenseMin.y)
-		distance = min + radius
-		return math.max(-distance, 0)
+	if dx > 0 and dy > 0 then
+		distance = math.sqrt(dx * dx + dy * dy)
+	else
+		distance = math.max(dx, dy)
 	end
-	distance = pos:distanceTo(geom.boundRect(defenseMin, pos, defenseMax)) - radius
-	return math.max(distance, 0)
+	return distance - area.cornerRadius
 end
+local signedDistanceToDefenseArea = Field.signedDistanceToDefenseArea
 
-local function distanceToDefenseArea_2017(pos, radius, friendly)
-	radius = radius + G.DefenseRadius
-	local defenseY = friendly and -G.FieldHeightHalf or G.FieldHeightHalf
-	local inside = Vector(math.bound(-G.DefenseStretchHalf, pos.x, G.DefenseStretchHalf), defenseY)
-	local distance = pos:distanceTo(inside) - radius
-	return (distance < 0) and 0 or distance
+--- Calculates the squared distance to the defense area, zero inside
+-- @name distanceToDefenseAreaSq
+-- @param pos Vector - the position to check
+-- @param friendly bool - selection of Own/Opponent area
+-- @return number - squared distance
+function Field.distanceToDefenseAreaSq(pos, friendly)
+	local distance = math.max(signedDistanceToDefenseArea(pos.x, pos.y, friendly), 0)
+	return distance * distance
 end
-local function distanceToDefenseAreaSq_2017(pos, friendly)
-	local d = distanceToDefenseArea_2017(pos, 0, friendly)
-	return d * d
+
+--- Calculates the distance (between robot hull and field line) to the defense area
+-- @name distanceToDefenseArea
+-- @param pos Vector - the position to check
+-- @param radius number - Radius of object to check
+-- @param friendly bool - selection of Own/Opponent area
+-- @return number - distance, zero if the object touches the area
+function Field.distanceToDefenseArea(pos, radius, friendly)
+	return math.max(signedDistanceToDefenseArea(pos.x, pos.y, friendly) - radius, 0)
 end
 
 --- check if position is inside/touching the (friendly) defense area
@@ -298,27 +280,37 @@ end
 -- @param radius number - Radius of object to check
 -- @param friendly bool - selection of Own/Opponent area
 -- @return bool
+function Field.isInDefenseArea(pos, radius, friendly)
+	return signedDistanceToDefenseArea(pos.x, pos.y, friendly) <= radius
+end
 
-local function isInDefenseArea_2017(pos, radius, friendly)
-	if radius < -G.DefenseRadius then
-		return false
+--- Calculates the signed distance to the defense area for every robot at once
+-- @name signedDistancesToDefenseArea
+-- @param robots Robot[] - robots to check
+-- @param friendly bool - selection of Own/Opponent area
+-- @param result table - is filled with the distance of the robot centers, negative inside
+-- @return table - the result table
+function Field.signedDistancesToDefenseArea(robots, friendly, result)
+	for i = 1, #robots do
+		local pos = robots[i].pos
+		result[i] = signedDistanceToDefenseArea(pos.x, pos.y, friendly)
+	end
+	for i = #robots + 1, #result do
+		result[i] = nil
 	end
-	radius = radius + G.DefenseRadius
-	local defenseY = friendly and -G.FieldHeightHalf or G.FieldHeightHalf
-	local inside = Vector(math.bound(-G.DefenseStretchHalf, pos.x, G.DefenseStretchHalf), defenseY)
-	return pos:distanceToSq(inside) <= radius * radius
+	return result
 end
 
-if World.RULEVERSION == "2018" then
-	Field.distanceToDefenseAreaSq = distanceToDefenseAreaSq_2018
-	Field.distanceToDefenseArea = distanceToDefenseArea_2018
-	Field.isInDefenseArea = isInDefenseArea_2018
-	Field.limitToAllowedField = limitToAllowedField_2018
-else
-	Field.distanceToDefenseAreaSq = distanceToDefenseAreaSq_2017
-	Field.distanceToDefenseArea = distanceToDefenseArea_2017
-	Field.isInDefenseArea = isInDefenseArea_2017
-	Field.limitToAllowedField = limitToAllowedField_2017
+--- returns the nearest position inside the field without defense areas
+-- @name limitToAllowedField
+-- @param pos Vector - the position to limit
+-- @param extraLimit number - how much the field should be additionally limited
+-- @return Vector - limited vector
+function Field.limitToAllowedField(pos, extraLimit)
+	if World.RULEVERSION == "2018" then
+		return limitToAllowedField_2018(pos, extraLimit)
+	end
+	return limitToAllowedField_2017(pos, extraLimit)
 end
 
 
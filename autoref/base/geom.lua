@@ -183,24 +183,27 @@ end
 -- @return number - lambda1, intersection = pos1 + lambda1*dir1
 -- @return number] - lambda2, intersection = pos2 + lambda2*dir2
 function geom.intersectLineLine(pos1, dir1, pos2, dir2)
+	-- work on the coordinates to only allocate the intersection
+	local d1x, d1y = dir1.x, dir1.y
+	local d2x, d2y = dir2.x, dir2.y
+	local diffX, diffY = pos2.x - pos1.x, pos2.y - pos1.y
+	-- cross product of the directions, equals dir1:perpendicular():dot(dir2)
+	local cross = d1y * d2x - d1x * d2y
 	-- check whether the directions are collinear
-	if math.abs(dir1:perpendicular():dot(dir2)) / (dir1:length() * dir2:length()) < 0.0001 then
+	if math.abs(cross) / (dir1:length() * dir2:length()) < 0.0001 then
 		-- check whether connection vector of pos is collinear to dir
-		local d = pos2 - pos1
-		if math.abs(d:perpendicular():dot(dir1)) / (dir1:length() * d:length()) < 0.0001 then
+		local diffLength = math.sqrt(diffX * diffX + diffY * diffY)
+		if math.abs(diffY * d1x - diffX * d1y) / (dir1:length() * diffLength) < 0.0001 then
 			return pos1, 0, 0
 		else
 			return
 		end
 	end
 
-	local normal1 = dir1:perpendicular()
-	local normal2 = dir2:perpendicular()
-	local diff = pos2 - pos1
-	local t1 = normal2:dot(diff) / normal2:dot(dir1)
-	local t2 = -normal1:dot(diff) / normal1:dot(dir2)
+	local t1 = (d2y * diffX - d2x * diffY) / -cross
+	local t2 = -(d1y * diffX - d1x * diffY) / cross
 
-	return pos1 + (dir1 * t1), t1, t2
+	return Vector(pos1.x + d1x * t1, pos1.y + d1y * t1), t1, t2
 end
 
 --- Intersects two lines given as points.
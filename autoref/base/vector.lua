@@ -138,6 +138,37 @@ function vector_mt:scaleLength(scale)
 	return self
 end
 
+--- Overwrite the coordinates of the current vector.
+-- Allows reusing a vector as accumulator instead of creating a new one
+-- @param x number - new x coordinate
+-- @param y number - new y coordinate
+-- @return Vector - reference to self
+function vector_mt:set(x, y)
+	self.x = x
+	self.y = y
+	return self
+end
+
+--- Add other vector to the current vector.
+-- In-place variant of +, that doesn't allocate a new vector
+-- @param other Vector
+-- @return Vector - reference to self
+function vector_mt:addInPlace(other)
+	self.x = self.x + other.x
+	self.y = self.y + other.y
+	return self
+end
+
+--- Subtract other vector from the current vector.
+-- In-place variant of -, that doesn't allocate a new vector
+-- @param other Vector
+-- @return Vector - reference to self
+function vector_mt:subInPlace(other)
+	self.x = self.x - other.x
+	self.y = self.y - other.y
+	return self
+end
+
 --- Distance between vectors.
 -- distance = (other - self):length()
 -- @param other Vector
@@ -229,16 +260,16 @@ end
 -- @return Vector - projected point
 -- @return number - (signed) distance to line
 function vector_mt:orthogonalProjection(linePoint1, linePoint2)
-	local rv = linePoint2 - linePoint1
-	if rv:lengthSq() < 0.00001 * 0.00001 then
+	local rx = linePoint2.x - linePoint1.x
+	local ry = linePoint2.y - linePoint1.y
+	local lengthSq = rx * rx + ry * ry
+	if lengthSq < 0.00001 * 0.00001 then
 		return linePoint1, self:distanceTo(linePoint1)
 	end
-	local is, dist = geom.intersectLineLine(self, rv:perpendicular(), linePoint1, rv)
-	if is then
-		return is, dist * rv:length()
-	else
-		return self, 0
-	end
+	-- intersect the line with its perpendicular through self,
+	-- written out to only allocate the result
+	local t = (ry * (linePoint1.x - self.x) - rx * (linePoint1.y - self.y)) / lengthSq
+	return vector_c(self.x + ry * t, self.y - rx * t), t * sqrt(lengthSq)
 end
 
 --- Distance value of orthogonalProjection
@@ -259,19 +290,25 @@ end
 -- @param lineEnd Vector - end of line
 -- @return number - distance
 function vector_mt:distanceToLineSegment(lineStart, lineEnd)
-	local dir = (lineEnd - lineStart):normalize()
-	local d = self - lineStart
-	if d:dot(dir) < 0 then
-		return d:length()
+	local dirX = lineEnd.x - lineStart.x
+	local dirY = lineEnd.y - lineStart.y
+	local dx = self.x - lineStart.x
+	local dy = self.y - lineStart.y
+	if dx * dirX + dy * dirY < 0 then
+		return sqrt(dx * dx + dy * dy)
 	end
-	d = self - lineEnd
-	if d:dot(dir) > 0 then
-		return d:length()
+	dx = self.x - lineEnd.x
+	dy = self.y - lineEnd.y
+	if dx * dirX + dy * dirY > 0 then
+		return sqrt(dx * dx + dy * dy)
 	end
 
-	--local normal = dir:perpendicular()
-	--return math.abs(d:dot(normal))
-	return abs(d.x * dir.y - d.y * dir.x)
+	-- distance to the line, the sign tests above don't need a normalized direction
+	local l = sqrt(dirX * dirX + dirY * dirY)
+	if l == 0 then
+		return 0
+	end
+	return abs(dx * dirY - dy * dirX) / l
 end
 
 --- Calculates the point on a line segment with the shortest distance to a given point.
@@ -280,16 +317,15 @@ end
 -- @param lineStart Vector - the start point of the line
 -- @param lineEnd Vector - the end point of the line
 function vector_mt:nearestPosOnLine(lineStart, lineEnd)
-	local dir = (lineEnd - lineStart)
-	if (self - lineStart):dot(dir) <= 0 then
+	local d1, d2 = lineEnd.x - lineStart.x, lineEnd.y - lineStart.y
+	local p1, p2 = lineStart.x, lineStart.y
+	local a1, a2 = self.x, self.y
+	if (a1 - p1) * d1 + (a2 - p2) * d2 <= 0 then
 		return lineStart
-	elseif (self - lineEnd):dot(dir) >= 0 then
+	elseif (a1 - lineEnd.x) * d1 + (a2 - lineEnd.y) * d2 >= 0 then
 		return lineEnd
 	end
 	--the code below this line does the same as Vector.orthogonalProjection
-	local d1, d2 = dir.x, dir.y
-	local p1, p2 = lineStart.x, lineStart.y
-	local a1, a2 = self.x, self.y
 	local x1 = (d1*d1*a1 + d1*d2*(a2-p2) + d2*d2*p1)/(d1*d1 + d2*d2)
 	local x2 = (d2*d2*a2 + d2*d1*(a1-p1) + d1*d1*p2)/(d2*d2 + d1*d1)
 	return vector_c(x1, x2)
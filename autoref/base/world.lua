@@ -27,9 +27,11 @@ module "World"
 local amun = amun
 local Ball = require "base/ball"
 local Constants = require "base/constants"
+local DistanceMatrix = require "base/distancematrix"
 local Robot = require "base/robot"
 
 --- Ball and team informations.
+-- The robot lists are updated in place every frame, copy them to keep the robots of a frame.
 -- @class table
 -- @name World
 -- @field Ball Ball - current Ball
@@ -47,6 +49,7 @@ local Robot = require "base/robot"
 -- @field BlueKeeper Robot - Blue keeper if on field or nil
 -- @field BlueRobotsNumberAllowed number - number of blue robots that are allowed on the field
 -- @field Robots Robot[] - Every visible robot in an arbitary order
+-- @field Distances DistanceMatrix - Distances and relative speeds between every visible robot and the ball
 -- @field TeamIsBlue bool - True if we are the blue team, otherwise we're yellow
 -- @field IsSimulated bool - True if the world is simulated
 -- @field IsLargeField bool - True if playing on the large field
@@ -83,6 +86,7 @@ World.BlueRobotsVisible = {}
 World.BlueKeeper = nil
 World.BlueColorStr = "<font color=\"blue\">blue</font>"
 World.Robots = {}
+World.Distances = DistanceMatrix()
 World.TeamIsBlue = false
 World.IsSimulated = false
 World.IsLargeField = false
@@ -129,14 +133,17 @@ World.Geometry = {}
 -- @field BoundaryWidthGoalLine number - Free distance from the goal line to the wall
 -- @field GoalSubstitutionAreaPosY number - Y position that marks the border to the substitution area
 -- @field RefereeWidth number - Width of area reserved for referee
+-- @field YellowDefenseArea table - Yellow defense area as rounded rectangle, see Field.signedDistanceToDefenseArea
+-- @field BlueDefenseArea table - Blue defense area as rounded rectangle
 
 -- initializes Team and Geometry data
 function World._init()
 	assert(not amun.isBlue(), "Must be run as yellow strategy or autoref!")
 	World.TeamIsBlue = false
 	local geom = amun.getGeometry()
-	World._updateGeometry(geom)
+	-- the shape of the defense areas depends on the rule version
 	World._updateRuleVersion(geom)
+	World._updateGeometry(geom)
 	World._updateTeam()
 end
 
@@ -213,11 +220,58 @@ function World._updateGeometry(geom)
 
 	wgeom.RefereeWidth = geom.referee_width
 
+	-- both rule versions describe the defense area as rectangle with rounded corners,
+	-- since 2018 the corners are sharp, before it was a stretched quarter circle
+	local defenseArea
+	if World.RULEVERSION == "2018" then
+		defenseArea = {
+			centerX = 0,
+			centerY = wgeom.FieldHeightHalf - wgeom.DefenseHeight / 2,
+			halfWidth = wgeom.DefenseWidthHalf,
+			halfHeight = wgeom.DefenseHeight / 2,
+			cornerRadius = 0
+		}
+	else
+		defenseArea = {
+			centerX = 0,
+			centerY = wgeom.FieldHeightHalf,
+			halfWidth = wgeom.DefenseStretchHalf,
+			halfHeight = 0,
+			cornerRadius = wgeom.DefenseRadius
+		}
+	end
+	wgeom.BlueDefenseArea = defenseArea
+	wgeom.YellowDefenseArea = table.copy(defenseArea)
+	wgeom.YellowDefenseArea.centerY = -defenseArea.centerY
+
 	World.Geometry = table.readonlytable(World.Geometry)
 
 	World.IsLargeField = wgeom.FieldWidth > 5 and wgeom.FieldHeight > 7
 end
 
+-- the robot lists are reused every frame to avoid creating garbage
+local dataById = {}
+local generation = 0
+
+-- removes the entries after count without releasing the array
+local function truncate(list, count)
+	for i = #list, count + 1, -1 do
+		list[i] = nil
+	end
+end
+
+-- replaces the content of target with the entries of a followed by those of b
+local function concat(target, a, b)
+	local count = #a
+	for i = 1, count do
+		target[i] = a[i]
+	end
+	for i = 1, #b do
+		target[count + i] = b[i]
+	end
+	truncate(target, count + #b)
+end
+
 function World._updateWorld(state)
 	-- Get time
 	if World.Time then
@@ -242,66 +296,77 @@ function World._updateWorld(state)
 	local dataFriendly = World.TeamIsBlue and state.blue or state.yellow
 	if dataFriendly then
 		-- sort data by robot id
-		local dataById = {}
 		for _,rdata in ipairs(dataFriendly) do
 			dataById[rdata.id] = rdata
 		end
 
 		-- Update data of every own robot
-		World.YellowRobots = {}
-		World.YellowInvisibleRobots = {}
-		World.YellowRobotsInExchangeArea = {}
+		local robots, invisible, exchange = World.YellowRobots, World.YellowInvisibleRobots, World.YellowRobotsInExchangeArea
+		local robotCount, invisibleCount, exchangeCount = 0, 0, 0
 		for _, robot in pairs(World.YellowRobotsById) do
 			robot:_update(dataById[robot.id], World.Time)
 			-- sort robot into visible / not visible
 			if not robot.isVisible then
-				table.insert(World.YellowInvisibleRobots, robot)
+				invisibleCount = invisibleCount + 1
+				invisible[invisibleCount] = robot
 			elseif World.Geometry.GoalSubstitutionAreaPosY ~= nil and robot.pos.y < World.Geometry.GoalSubstitutionAreaPosY - Constants.maxRobotRadius then
-				table.insert(World.YellowRobotsInExchangeArea, robot)
+				exchangeCount = exchangeCount + 1
+				exchange[exchangeCount] = robot
 			else
-				table.insert(World.YellowRobots, robot)
+				robotCount = robotCount + 1
+				robots[robotCount] = robot
 			end
 		end
+		truncate(robots, robotCount)
+		truncate(invisible, invisibleCount)
+		truncate(exchange, exchangeCount)
+
+		for _,rdata in ipairs(dataFriendly) do
+			dataById[rdata.id] = nil
+		end
 	end
 
 	local dataOpponent = World.TeamIsBlue and state.yellow or state.blue
 	if dataOpponent then
-		-- only keep robots that are still existent
-		local opponentRobotsById = World.BlueRobotsById
-		World.BlueRobots = {}
-		World.BlueRobotsInExchangeArea = {}
-		World.BlueRobotsById = {}
+		-- robots that were not part of this update are tagged with an older generation
+		generation = generation + 1
+		local robotsById = World.BlueRobotsById
+		local robots, exchange = World.BlueRobots, World.BlueRobotsInExchangeArea
+		local robotCount, exchangeCount = 0, 0
 		-- just update every opponent robot
 		-- robots that are invisible for more than one second are dropped by amun
 		for _,rdata in ipairs(dataOpponent) do
-			local robot = opponentRobotsById[rdata.id]
-			opponentRobotsById[rdata.id] = nil
+			local robot = robotsById[rdata.id]
 			if not robot then
 				robot = Robot(rdata.id, false)
+				robotsById[rdata.id] = robot
 			end
+			robot._generation = generation
 			robot:_update(rdata, World.Time)
 			-- don't add robots that are in the blue goal substitution area to the BlueRobots
 			if World.Geometry.GoalSubstitutionAreaPosY ~= nil and robot.pos.y > -(World.Geometry.GoalSubstitutionAreaPosY - Constants.maxRobotRadius) then
-				table.insert(World.BlueRobotsInExchangeArea, robot)
+				exchangeCount = exchangeCount + 1
+				exchange[exchangeCount] = robot
 			else
-				table.insert(World.BlueRobots, robot)
+				robotCount = robotCount + 1
+				robots[robotCount] = robot
 			end
-			World.BlueRobotsById[rdata.id] = robot
 		end
-		-- mark dropped robots as invisible
-		for _,robot in pairs(opponentRobotsById) do
-			robot:_update(nil, World.Time)
+		truncate(robots, robotCount)
+		truncate(exchange, exchangeCount)
+		-- mark dropped robots as invisible and only keep robots that are still existent
+		for id, robot in pairs(robotsById) do
+			if robot._generation ~= generation then
+				robot:_update(nil, World.Time)
+				robotsById[id] = nil
+			end
 		end
 	end
 
-	World.YellowRobotsVisible = table.copy(World.YellowRobots)
-	table.append(World.YellowRobotsVisible, World.YellowRobotsInExchangeArea)
-
-	World.BlueRobotsVisible = table.copy(World.BlueRobots)
-	table.append(World.BlueRobotsVisible, World.BlueRobotsInExchangeArea)
-
-	World.Robots = table.copy(World.YellowRobotsVisible)
-	table.append(World.Robots, World.BlueRobotsVisible)
+	concat(World.YellowRobotsVisible, World.YellowRobots, World.YellowRobotsInExchangeArea)
+	concat(World.BlueRobotsVisible, World.BlueRobots, World.BlueRobotsInExchangeArea)
+	concat(World.Robots, World.YellowRobotsVisible, World.BlueRobotsVisible)
+	World.Distances:_update(World.Robots, World.Ball, World.Time)
 
 	-- no vision data only if the parameter is false
 	return state.has_vision_data ~= false
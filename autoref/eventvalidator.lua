@@ -25,19 +25,28 @@ local LastTouch = require "validation-rules/lasttouch"
 
 local GameEvents = require "gameevents"
 local GameController = require "gamecontroller"
+local RuleProfiler = require "ruleprofiler"
+
+-- names of the rule classes for profiling
+local ruleNames = {}
+local function requireRule(path)
+	local rule = require(path)
+	ruleNames[rule] = "validation " .. path:match("[^/]+$")
+	return rule
+end
 
 -- rules
--- local DoubleTouch = require "validation-rules/doubletouch"
-local OutOfField = require "validation-rules/outoffield"
-local FastShot = require "validation-rules/fastshot"
-local FreekickDistance = require "validation-rules/freekickdistance"
-local PlacementSuccess = require "validation-rules/placementsuccess"
-local AttackerDefAreaDist = require "rules/attackerdefareadist"
-local AttackerInDefenseArea = require "rules/attackerindefensearea"
-local MultipleDefender = require "rules/multipledefender"
-local PlacementInterference = require "rules/placementinterference"
-local StopSpeed  = require "rules/stopspeed"
-local Collision = require "rules/collision"
+-- local DoubleTouch = requireRule "validation-rules/doubletouch"
+local OutOfField = requireRule "validation-rules/outoffield"
+local FastShot = requireRule "validation-rules/fastshot"
+local FreekickDistance = requireRule "validation-rules/freekickdistance"
+local PlacementSuccess = requireRule "validation-rules/placementsuccess"
+local AttackerDefAreaDist = requireRule "rules/attackerdefareadist"
+local AttackerInDefenseArea = requireRule "rules/attackerindefensearea"
+local MultipleDefender = requireRule "rules/multipledefender"
+local PlacementInterference = requireRule "rules/placementinterference"
+local StopSpeed  = requireRule "rules/stopspeed"
+local Collision = requireRule "rules/collision"
 
 local EventValidator = {}
 
@@ -56,6 +65,7 @@ local foulClasses = {
 	Collision
 }
 local fouls = nil
+local foulNames = {}
 
 local SUPPORTED_EVENTS = {
 	-- "ATTACKER_DOUBLE_TOUCHED_BALL",
@@ -85,7 +95,7 @@ local function runEvent(foul)
 	local simpleRefState = TrueWorld.RefereeState:match("%u%l+")
 	if foul.possibleRefStates[simpleRefState] and
 			(foul.shouldAlwaysExecute or not foulTimes[foul] or TrueWorld.Time - foulTimes[foul] > FOUL_TIMEOUT) then
-		local event = foul:occuring()
+		local event = RuleProfiler.run(foulNames[foul], foul.occuring, foul)
 		if event then
 			foulTimes[foul] = TrueWorld.Time
 
@@ -104,12 +114,28 @@ local waitingEvents = {
 }
 
 local eventsThisFrame = {}
+-- number of the events sent in the frame of sentEventsTime
+local sentEventsCount = 0
+local sentEventsTime = nil
 
 function EventValidator.sendEvent(event, fromTracked, fromValidation)
 	log(GameEvents.eventMessage(event) .. " [" .. (fromTracked and "R" or "") .. ((fromTracked and fromValidation) and ", " or "") ..
 		(fromValidation and "VR" or "") .. "]")
 	GameController.sendEvent(event)
 	eventsThisFrame[event.type] = true
+
+	if sentEventsTime ~= TrackedWorld.Time then
+		sentEventsTime = TrackedWorld.Time
+		sentEventsCount = 0
+	end
+	sentEventsCount = sentEventsCount + 1
+	-- read by autoref-cli for its structured output, do not rename.
+	-- Events of the same type can be sent more than once per frame,
+	-- thus every event gets its own index
+	debug.pushtop("Sent game events/" .. sentEventsCount)
+	debug.set("type", event.type)
+	debug.set("message", GameEvents.eventMessage(event))
+	debug.pop()
 end
 
 function EventValidator.checkEvent(event, source)
@@ -167,6 +193,7 @@ function EventValidator.update()
 			local inst = foul(TrueWorld)
 			inst:reset()
 			table.insert(fouls, inst)
+			foulNames[inst] = ruleNames[foul]
 		end
 	end
 
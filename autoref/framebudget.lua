@@ -0,0 +1,184 @@
+--[[
+--- Per frame time budget and watchdog for the autoref rules.
+-- Every part of a frame is run using FrameBudget.run. Every part is run even if the frame budget is used
+-- up, an overrun is only counted and reported together with the slowest part. Parts which run longer than
+-- the watchdog limit are aborted, which only works if the lua debug library is available and the code is
+-- not jit compiled. The previous decisions of aborted parts are kept.
+module "FrameBudget"
+]]--
+
+--[[***********************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+*************************************************************************]]
+
+local FrameBudget = {}
+
+local amun = amun
+local luaDebug = debug
+local debug = require "base/debug"
+
+local DEFAULT_BUDGET = 0.010 -- s
+local budget = DEFAULT_BUDGET
+local watchdogLimit = 0.1 -- s
+local WATCHDOG_INSTRUCTIONS = 10000 -- instructions between watchdog checks
+local WARNING_INTERVAL = 1 -- s, minimum time between overrun warnings
+
+--- Strategy options to select a different frame budget, the budget of the first selected one is used
+-- @name budgetOptions
+FrameBudget.budgetOptions = {
+	{ name = "Frame budget: 5 ms", budget = 0.005 },
+	{ name = "Frame budget: 20 ms", budget = 0.020 },
+	{ name = "Frame budget: 50 ms", budget = 0.050 },
+}
+
+-- unique value thrown by the watchdog
+local WATCHDOG_ABORT = {}
+
+local frameStart = 0
+local partStart = 0
+local slowestName = nil
+local slowestTime = 0
+-- the watchdog only aborts while a part is running
+local isPartRunning = false
+local isHookInstalled = false
+
+local overrunCount = 0
+local abortCount = 0
+local lastWarning = -math.huge
+
+--- Sets the time budget and the watchdog limit of a frame
+-- @name configure
+-- @param frameBudget number - time in seconds after which a frame counts as overrun
+-- @param hardLimit number - time in seconds after which the running part is aborted
+function FrameBudget.configure(frameBudget, hardLimit)
+	budget = frameBudget
+	watchdogLimit = hardLimit
+end
+
+--- Selects the frame budget according to the strategy options
+-- @name configureFromOptions
+-- @param selectedOptions string[] - names of the selected strategy options
+function FrameBudget.configureFromOptions(selectedOptions)
+	local selected = {}
+	for _, name in ipairs(selectedOptions) do
+		selected[name] = true
+	end
+	budget = DEFAULT_BUDGET
+	for _, option in ipairs(FrameBudget.budgetOptions) do
+		if selected[option.name] then
+			budget = option.budget
+			break
+		end
+	end
+end
+
+local function watchdogHook()
+	if isPartRunning and amun.getCurrentTime() - partStart > watchdogLimit then
+		error(WATCHDOG_ABORT)
+	end
+end
+
+--- Must be called before the first part of a frame is run
+-- @name startFrame
+function FrameBudget.startFrame()
+	frameStart = amun.getCurrentTime()
+	slowestName = nil
+	slowestTime = 0
+	-- installed once per frame, as setting a hook is costly for interpreted code,
+	-- don't interfere with the debugger, which uses a hook as well
+	if luaDebug and luaDebug.sethook and not luaDebug.gethook() then
+		luaDebug.sethook(watchdogHook, "", WATCHDOG_INSTRUCTIONS)
+		isHookInstalled = true
+	end
+end
+
+local function errorHandler(err)
+	if err == WATCHDOG_ABORT then
+		return err
+	end
+	return luaDebug.traceback(tostring(err), 2)
+end
+
+local function finishPart(name, start, ok, ...)
+	isPartRunning = false
+	local duration = amun.getCurrentTime() - start
+	if duration > slowestTime then
+		slowestTime = duration
+		slowestName = name
+	end
+	if not ok then
+		local err = ...
+		if err ~= WATCHDOG_ABORT then
+			error(err, 0)
+		end
+		abortCount = abortCount + 1
+		log("<font color=\"red\">Watchdog: aborted " .. name .. " after "
+			.. string.format("%.1f", duration * 1000) .. " ms</font>")
+		return false
+	end
+	return true, ...
+end
+
+--- Runs a part of the frame
+-- @name run
+-- @param name string - name used for the slowest part attribution
+-- @param func function - function to run, errors are passed on
+-- @param ... any - arguments for func
+-- @return boolean - true if the part ran to completion, false if it was aborted by the watchdog
+-- @return any - the results of func if it ran to completion
+function FrameBudget.run(name, func, ...)
+	local start = amun.getCurrentTime()
+	if isHookInstalled then
+		-- the watchdog limit applies to each part, thus a slow part doesn't abort the following ones
+		partStart = start
+		isPartRunning = true
+		return finishPart(name, start, xpcall(func, errorHandler, ...))
+	end
+	return finishPart(name, start, true, func(...))
+end
+
+--- Must be called after the last part of a frame, reports overruns
+-- @name finishFrame
+function FrameBudget.finishFrame()
+	if isHookInstalled then
+		luaDebug.sethook()
+		isHookInstalled = false
+	end
+
+	local now = amun.getCurrentTime()
+	local frameTime = now - frameStart
+	if frameTime > budget then
+		overrunCount = overrunCount + 1
+		if now - lastWarning > WARNING_INTERVAL then
+			lastWarning = now
+			log(string.format("<font color=\"red\">Frame budget exceeded: %.1f ms, slowest part %s (%.1f ms)</font>",
+				frameTime * 1000, tostring(slowestName), slowestTime * 1000))
+		end
+	end
+
+	debug.pushtop("Frame budget")
+	debug.set("frame time", frameTime)
+	debug.set("budget", budget)
+	debug.set("overruns", overrunCount)
+	debug.set("watchdog aborts", abortCount)
+	debug.set("slowest part", slowestName)
+	debug.set("slowest part time", slowestTime)
+	debug.pop()
+end
+
+return FrameBudget
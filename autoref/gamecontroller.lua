@@ -18,31 +18,136 @@
 *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
 *************************************************************************]]
 
+local debug = require "base/debug"
+local World = require "base/world"
+
 local GameController = {}
 
 local STATE_UNCONNECTED = 1
 local STATE_CONNECTED = 2
 
+local MAX_QUEUED_EVENTS = 64
+-- the game controller would apply outdated events to a different situation
+local MAX_EVENT_AGE = 1 -- s
+local MIN_RECONNECT_DELAY = 0.05 -- s
+local MAX_RECONNECT_DELAY = 2 -- s
+
 local state = STATE_UNCONNECTED
+local wasConnected = false
+local reconnectDelay = MIN_RECONNECT_DELAY
+local nextConnectAttempt = -math.huge
 
-function GameController.update()
+-- ring buffer of {event, enqueue time}, events are sent at the end of a frame
+local queue = {}
+local queueFirst = 1
+local queueLast = 0
+
+local reconnectCount = 0
+local droppedCount = 0
+
+local function queueDepth()
+	return queueLast - queueFirst + 1
+end
+
+local function dropOldest()
+	queue[queueFirst] = nil
+	queueFirst = queueFirst + 1
+	droppedCount = droppedCount + 1
+end
+
+local function connect()
+	local now = amun.getCurrentTime()
+	-- a missing game controller must not cause a connection attempt per frame
+	if state == STATE_UNCONNECTED and now < nextConnectAttempt then
+		return
+	end
 	if amun.connectGameController() then
 		if state == STATE_UNCONNECTED then
 			state = STATE_CONNECTED
+			reconnectDelay = MIN_RECONNECT_DELAY
+			if wasConnected then
+				reconnectCount = reconnectCount + 1
+			end
+			wasConnected = true
 			amun.sendGameControllerMessage("AutoRefRegistration", {identifier="ER-Force"})
 		end
-
 	else
+		if state == STATE_CONNECTED then
+			log("Lost connection to game controller")
+		end
 		state = STATE_UNCONNECTED
+		nextConnectAttempt = now + reconnectDelay
+		reconnectDelay = math.min(reconnectDelay * 2, MAX_RECONNECT_DELAY)
 	end
 end
 
+--- Keeps the connection to the game controller alive
+-- Must be called at the start of every frame, even without vision data
+-- @name update
+function GameController.update()
+	connect()
+	-- read by the metrics endpoint of autoref-cli, do not rename
+	debug.pushtop("Game controller")
+	debug.set("connected", state == STATE_CONNECTED)
+	debug.pop()
+end
+
+--- Queues a game event, it is sent by the next call to flush
+-- @name sendEvent
+-- @param event table - game event without origin
 function GameController.sendEvent(event)
 	event.origin = {"ER-Force"}
-	if state == STATE_CONNECTED then
-		amun.sendGameControllerMessage("AutoRefToController", {game_event=event})
-	else
-		log("Not connected to game controller!")
+	if queueDepth() >= MAX_QUEUED_EVENTS then
+		dropOldest()
+	end
+	queueLast = queueLast + 1
+	queue[queueLast] = {event, amun.getCurrentTime()}
+end
+
+--- Sends all queued game events in one batch
+-- Must be called once per frame after the rules have run. Events are kept
+-- while the game controller is unreachable, unless they become outdated.
+-- @name flush
+function GameController.flush()
+	local now = amun.getCurrentTime()
+	local sent = 0
+	local maxLatency = 0
+	local totalLatency = 0
+	while queueFirst <= queueLast do
+		local entry = queue[queueFirst]
+		local latency = now - entry[2]
+		if latency > MAX_EVENT_AGE then
+			log("Dropped outdated game event " .. tostring(entry[1].type))
+			dropOldest()
+		elseif state ~= STATE_CONNECTED then
+			break
+		else
+			amun.sendGameControllerMessage("AutoRefToController", {game_event=entry[1]})
+			queue[queueFirst] = nil
+			queueFirst = queueFirst + 1
+			sent = sent + 1
+			totalLatency = totalLatency + latency
+			maxLatency = math.max(maxLatency, latency)
+		end
+	end
+
+	-- read by the metrics endpoint of autoref-cli, do not rename
+	debug.pushtop("Game controller")
+	debug.set("queue depth", queueDepth())
+	debug.set("reconnects", reconnectCount)
+	debug.set("dropped events", droppedCount)
+	if sent > 0 then
+		debug.set("sent events", sent)
+		-- from queueing an event until it is passed to the game controller connection,
+		-- this does not include the transmission to the game controller
+		debug.set("queue latency/mean", totalLatency / sent)
+		debug.set("queue latency/max", maxLatency)
+	end
+	debug.pop()
+	if sent > 0 then
+		debug.pushtop("Latency")
+		debug.set("tracking to game event", now - World.Time)
+		debug.pop()
 	end
 end
 
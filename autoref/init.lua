@@ -20,8 +20,11 @@
 *************************************************************************]]
 
 require("base/globalschecker").enable()
+local StartupTimeline = require "startuptimeline"
 require "base/base"
+StartupTimeline.mark("base loaded")
 
+local Cache = require "base/cache"
 local Entrypoints = require "base/entrypoints"
 local debug = require "base/debug"
 local Referee = require "base/referee"
@@ -31,8 +34,11 @@ local World = require "base/world"
 local plot = require "base/plot"
 
 local BallObserver = require "ballobserver"
+local FrameBudget = require "framebudget"
 local GameController = require "gamecontroller"
 local EventValidator = require "eventvalidator"
+local RuleProfiler = require "ruleprofiler"
+local VectorBenchmark = require "vectorbenchmark"
 
 local descriptionToFileNames = {
 	["Robot collisions"] = "collision",
@@ -50,6 +56,7 @@ local descriptionToFileNames = {
 }
 
 local fouls = nil
+local foulNames = {}
 local foulTimes = {}
 local FOUL_TIMEOUT = 3 -- minimum time between subsequent fouls of the same kind
 
@@ -63,8 +70,12 @@ local function runEvent(foul)
 	local simpleRefState = World.RefereeState:match("%u%l+")
 	if foul.possibleRefStates[simpleRefState] and
 			(foul.shouldAlwaysExecute or not foulTimes[foul] or World.Time - foulTimes[foul] > FOUL_TIMEOUT) then
-		local event = foul:occuring()
-		if event then
+		-- only the rule itself is watched, an event is never dispatched by an aborted part
+		local completed, event = FrameBudget.run(foulNames[foul], RuleProfiler.run, foulNames[foul], foul.occuring, foul)
+		if not completed then
+			-- a rule aborted by the watchdog may be in an inconsistent state
+			foul:reset()
+		elseif event then
 			foulTimes[foul] = World.Time
 			-- TODO: sanity checks on occuring events
 
@@ -90,7 +101,7 @@ end
 
 local function main()
 	if World.HasTrueState then
-		EventValidator.update()
+		FrameBudget.run("event validator", EventValidator.update)
 	end
 
 	if World.BallPlacementPos then
@@ -104,7 +115,9 @@ local function main()
 			local foul = require("rules/" .. filename)()
 			foul:reset()
 			table.insert(fouls, foul)
+			foulNames[foul] = filename
 		end
+		StartupTimeline.mark("rules loaded")
 	end
 
 	for _, foul in ipairs(fouls) do
@@ -147,20 +160,59 @@ local function main()
 	Referee.illustrateRefereeStates()
 end
 
+local function debugLatency(entryTime)
+	-- Latencies relative to the tracking time of the current world state,
+	-- these are collected by amun, thus do not rename the keys
+	debug.pushtop("Latency")
+	debug.set("tracking to strategy entry", entryTime - World.Time)
+	debug.set("strategy run", amun.getCurrentTime() - entryTime)
+	debug.pop()
+end
+
+-- Memory allocated by the world update and the whole frame in bytes.
+-- A garbage collection step during the measurement frees memory, thus
+-- these are lower bounds.
+local function debugGarbage(frameStartMemory, worldStartMemory, worldEndMemory)
+	debug.pushtop("Garbage per frame")
+	debug.set("world update", math.max(worldEndMemory - worldStartMemory, 0) * 1024)
+	debug.set("frame", math.max(collectgarbage("count") - frameStartMemory, 0) * 1024)
+	debug.pop()
+end
+
+local configuredOptions = nil
+
 local function mainLoopWrapper(func)
 	return function()
+		local entryTime = amun.getCurrentTime()
+		local frameStartMemory = collectgarbage("count")
 		-- Connect to GameController even without vision data to avoid
 		-- confusion
 		GameController.update()
 
+		Cache.resetFrame()
+		local worldStartMemory = collectgarbage("count")
 		if not World.update() then
 			return -- skip processing if no vision data is available yet
 		end
+		local worldEndMemory = collectgarbage("count")
+		StartupTimeline.mark("first world state")
+		if World.SelectedOptions ~= configuredOptions then
+			configuredOptions = World.SelectedOptions
+			FrameBudget.configureFromOptions(configuredOptions)
+		end
 
 		BallObserver._update()
 
+		FrameBudget.startFrame()
 		func()
+		FrameBudget.finishFrame()
+		GameController.flush()
+		StartupTimeline.firstDecision()
+		RuleProfiler.report()
+		Cache.report()
 		plot._plotAggregated()
+		debugLatency(entryTime)
+		debugGarbage(frameStartMemory, worldStartMemory, worldEndMemory)
 	end
 end
 
@@ -171,4 +223,18 @@ Entrypoints.add("2021", function()
 	BallOwner.lastRobot()
 end)
 
-return {name = "AutoRef", entrypoints = Entrypoints.get(mainLoopWrapper)}
+-- compares the ffi Vector against a table based one on the current world state
+Entrypoints.add("benchmark/vector", function()
+	VectorBenchmark.run()
+	debug.resetStack()
+end)
+
+StartupTimeline.mark("init loaded")
+
+-- the options are shown in the options widget of the gui
+local options = {}
+for _, option in ipairs(FrameBudget.budgetOptions) do
+	table.insert(options, option.name)
+end
+
+return {name = "AutoRef", entrypoints = Entrypoints.get(mainLoopWrapper), options = options}
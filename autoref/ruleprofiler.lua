@@ -0,0 +1,120 @@
+--[[
+--- Per rule profiling of the time and memory spent in the rules.
+-- Only every SAMPLE_INTERVAL-th frame is profiled to keep the overhead out of the other frames.
+module "RuleProfiler"
+]]--
+
+--[[***********************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+*************************************************************************]]
+
+
+local RuleProfiler = {}
+
+local amun = amun
+local debug = require "base/debug"
+local metric = require "base/metric"
+local plot = require "base/plot"
+
+local SAMPLE_INTERVAL = 10 -- frames
+
+local profiles = {}
+local profileList = {}
+local frameCounter = 0
+local isSampled = true
+
+local function getProfile(name)
+	local profile = profiles[name]
+	if not profile then
+		profile = {
+			name = name,
+			-- avoid concatenating the names for every call
+			metricName = "rule time/" .. name,
+			plotName = "Rule time." .. name,
+			calls = 0,
+			totalTime = 0,
+			maxTime = 0,
+			frameTime = 0,
+			allocated = 0
+		}
+		profiles[name] = profile
+		table.insert(profileList, profile)
+	end
+	return profile
+end
+
+local function finish(profile, startTime, startMemory, ...)
+	local duration = amun.getCurrentTime() - startTime
+	-- a garbage collection step during the call can free more than was allocated
+	local allocated = math.max(collectgarbage("count") - startMemory, 0) * 1024
+
+	profile.calls = profile.calls + 1
+	profile.totalTime = profile.totalTime + duration
+	profile.maxTime = math.max(profile.maxTime, duration)
+	profile.frameTime = profile.frameTime + duration
+	profile.allocated = profile.allocated + allocated
+	metric.addMetric(profile.metricName, duration, 1)
+	return ...
+end
+
+--- Runs a rule function and adds its run time and allocated memory to the profile of the rule
+-- @name run
+-- @param name string - name of the rule
+-- @param func function - function to profile
+-- @param ... any - arguments for func
+-- @return any - the return values of func
+function RuleProfiler.run(name, func, ...)
+	if not isSampled then
+		return func(...)
+	end
+	local profile = getProfile(name)
+	local startMemory = collectgarbage("count")
+	local startTime = amun.getCurrentTime()
+	return finish(profile, startTime, startMemory, func(...))
+end
+
+--- Plots the time of every rule in a sampled frame and publishes the totals of the sampled calls in the debug tree
+-- The debug values below "Rule profile" are parsed by src/backend/ruleprofile.cpp, thus do not rename them.
+-- Must be called once at the end of every frame
+-- @name report
+function RuleProfiler.report()
+	local wasSampled = isSampled
+	frameCounter = frameCounter + 1
+	isSampled = frameCounter % SAMPLE_INTERVAL == 0
+	if not wasSampled then
+		return
+	end
+
+	debug.pushtop("Rule profile")
+	debug.set("sample interval", SAMPLE_INTERVAL)
+	for _, profile in ipairs(profileList) do
+		plot.addPlot(profile.plotName, profile.frameTime * 1000)
+		profile.frameTime = 0
+
+		debug.push(profile.name)
+		debug.set("calls", profile.calls)
+		debug.set("total [ms]", profile.totalTime * 1000)
+		debug.set("mean [ms]", profile.calls > 0 and profile.totalTime * 1000 / profile.calls or 0)
+		debug.set("max [ms]", profile.maxTime * 1000)
+		debug.set("allocated [B]", profile.allocated)
+		debug.pop()
+	end
+	debug.pop()
+end
+
+return RuleProfiler
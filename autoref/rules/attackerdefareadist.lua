@@ -37,6 +37,7 @@ local BUFFER_TIME = 2 -- as given by the rules
 
 function AttackerDefAreaDist:init(worldInjection)
 	self.World = worldInjection or (require "base/world")
+	self.distances = {}
 	self:reset()
 end
 
@@ -48,8 +49,11 @@ function AttackerDefAreaDist:occuring()
 
 	for offense, defense in pairs({Blue = "Yellow", Yellow = "Blue"}) do
 		-- only check Robots on field, because the robots in the exchange area cannot be close to the opponent defense area
-		for _, robot in ipairs(self.World[offense.."Robots"]) do
-			local distance = Field["distanceTo"..defense.."DefenseArea"](robot.pos, robot.radius)
+		local robots = self.World[offense.."Robots"]
+		Field.signedDistancesToDefenseArea(robots, defense == "Yellow", self.distances)
+		for i, robot in ipairs(robots) do
+			-- distance of the robot hull
+			local distance = math.max(self.distances[i] - robot.radius, 0)
 			if distance <= 0.2 and not self.closeRobotsInThisState[robot] then
 				local event = Event.attackerDefAreaDist(robot.isYellow, robot.id, robot.pos, distance)
 				self.closeRobotsInThisState[robot] = true
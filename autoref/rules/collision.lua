@@ -67,30 +67,22 @@ function Collision:occuring()
 	end
 
 	Collision.ignore = false
+	local distances = self.World.Distances
 	for offense, defense in pairs({Yellow = "Blue", Blue = "Yellow"}) do
 		for _, offRobot in ipairs(self.World[offense.."RobotsVisible"]) do
+			local offIndex = distances:indexOf(offRobot)
 			for _, defRobot in ipairs(self.World[defense.."RobotsVisible"]) do
-				local speedDiff = offRobot.speed - defRobot.speed
-				local projectedSpeed = (offRobot.pos + speedDiff):orthogonalProjection(offRobot.pos,
-					defRobot.pos):distanceTo(offRobot.pos) - self.assumedBreakSpeedDiff
-				local defSpeed = math.max(0, defRobot.speed:length() - self.assumedBreakSpeedDiff)
-				local offSpeed = math.max(0, offRobot.speed:length() - self.assumedBreakSpeedDiff)
-				local collisionPoint = (offRobot.pos + defRobot.pos) / 2
-				if offRobot.pos:distanceTo(defRobot.pos) <= self.collisionDistance
-						and projectedSpeed > COLLISION_SPEED and offSpeed > defSpeed
-						and not self.collidingRobots[offRobot] and not self.collidingRobots[defRobot] then
-
-					self.collidingRobots[offRobot] = self.World.Time
-					self.collidingRobots[defRobot] = self.World.Time
-					if offSpeed - defSpeed > COLLISION_SPEED_DIFF then
-						local speed = math.round(offRobot.speed:length() - self.assumedBreakSpeedDiff, 2)
-						local event = Event.botCrash(offRobot.isYellow, offRobot.id, defRobot.id, collisionPoint, speed, speedDiff)
-						return event
-					else
-						-- TODO: angle is not provided
-						local event = Event.botCrashBoth(offRobot.isYellow and offRobot.id or defRobot.id, offRobot.isYellow and defRobot.id or offRobot.id,
-							collisionPoint, speedDiff)
-						return event
+				local defIndex = distances:indexOf(defRobot)
+				-- the robots are swept between the frames, thus fast robots can't pass through each other
+				local impactTime, impactSpeed, offImpactSpeed, defImpactSpeed, s =
+					distances:sweptContactByIndex(offIndex, defIndex, self.collisionDistance)
+				if impactTime and not self.collidingRobots[offRobot] and not self.collidingRobots[defRobot] then
+					-- the speed difference projected onto the contact normal
+					local projectedSpeed = math.abs(impactSpeed) - self.assumedBreakSpeedDiff
+					local defSpeed = math.max(0, defImpactSpeed - self.assumedBreakSpeedDiff)
+					local offSpeed = math.max(0, offImpactSpeed - self.assumedBreakSpeedDiff)
+					if projectedSpeed > COLLISION_SPEED and offSpeed > defSpeed then
+						return self:_collisionEvent(offRobot, defRobot, offIndex, defIndex, s, impactTime, offSpeed, defSpeed)
 					end
 				end
 			end
@@ -98,4 +90,25 @@ function Collision:occuring()
 	end
 end
 
+function Collision:_collisionEvent(offRobot, defRobot, offIndex, defIndex, s, impactTime, offSpeed, defSpeed)
+	local distances = self.World.Distances
+	local offX, offY = distances:positionAt(offIndex, s)
+	local defX, defY = distances:positionAt(defIndex, s)
+	local collisionPoint = Vector((offX + defX) / 2, (offY + defY) / 2)
+	-- the robots may have braked or passed each other until the current frame
+	local offVelX, offVelY = distances:velocityAt(offIndex, s)
+	local defVelX, defVelY = distances:velocityAt(defIndex, s)
+	local speedDiff = math.sqrt((offVelX - defVelX)^2 + (offVelY - defVelY)^2)
+	self.collidingRobots[offRobot] = impactTime
+	self.collidingRobots[defRobot] = impactTime
+	if offSpeed - defSpeed > COLLISION_SPEED_DIFF then
+		local speed = math.round(offSpeed, 2)
+		return Event.botCrash(offRobot.isYellow, offRobot.id, defRobot.id, collisionPoint, speed, speedDiff)
+	else
+		-- TODO: angle is not provided
+		return Event.botCrashBoth(offRobot.isYellow and offRobot.id or defRobot.id, offRobot.isYellow and defRobot.id or offRobot.id,
+			collisionPoint, nil, speedDiff)
+	end
+end
+
 return Collision
@@ -37,13 +37,7 @@ function Dribbling:init()
 end
 
 function Dribbling:occuring()
-	local currentTouchingRobot
-	for _, robot in ipairs(World.Robots) do
-		if robot.pos:distanceTo(World.Ball.pos) <= Referee.touchDist then
-			currentTouchingRobot = robot
-			break
-		end
-	end
+	local currentTouchingRobot = World.Distances:firstRobotNearBall(Referee.touchDist)
 	if currentTouchingRobot then
 		if not self.dribblingStart or currentTouchingRobot ~= Referee.robotAndPosOfLastBallTouch() then
 			self.dribblingStart = currentTouchingRobot.pos:copy()
@@ -31,6 +31,7 @@ MultipleDefender.possibleRefStates = {
 
 function MultipleDefender:init(worldInjection)
 	self.World = worldInjection or (require "base/world")
+	self.distances = {}
 end
 
 function MultipleDefender:occuring()
@@ -39,10 +40,12 @@ function MultipleDefender:occuring()
 		defense = "Blue"
 	end
 	-- only check Robots on field, because the robots in the exchange area cannot be in the defense area
-	for _, robot in ipairs(self.World[defense.."Robots"]) do
-		local distThreshold = -robot.radius
+	local robots = self.World[defense.."Robots"]
+	Field.signedDistancesToDefenseArea(robots, defense == "Yellow", self.distances)
+	for i, robot in ipairs(robots) do
+		-- the whole robot has to be inside
 		if robot ~= self.World[defense.."Keeper"]
-				and Field["isIn"..defense.."DefenseArea"](robot.pos, distThreshold)
+				and self.distances[i] <= -robot.radius
 				and self:ballTouchesRobot(robot) then
 			local event = Event.multipleDefender(robot.isYellow, robot.id, robot.pos, nil)
 			return event
@@ -0,0 +1,68 @@
+--[[
+--- Measures the time from loading the autoref until its first decision.
+-- The phases are logged once the first frame has been processed.
+module "StartupTimeline"
+]]--
+
+--[[***********************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+*************************************************************************]]
+
+
+local StartupTimeline = {}
+
+require "base/amun"
+local BytecodeCache = require "base/bytecodecache"
+
+-- keep the original function, it returns nanoseconds and is hidden later on
+local getCurrentTime = amun.getCurrentTime
+local startTime = getCurrentTime()
+local phases = {}
+local isReported = false
+
+--- Records the end of a startup phase, only the first call per phase counts
+-- @name mark
+-- @param name string - name of the phase
+function StartupTimeline.mark(name)
+	if isReported or phases[name] then
+		return
+	end
+	phases[name] = true
+	table.insert(phases, { name = name, time = (getCurrentTime() - startTime) * 1E-6 })
+end
+
+--- Marks the first decision, logs the timeline and saves the bytecode cache
+-- @name firstDecision
+function StartupTimeline.firstDecision()
+	if isReported then
+		return
+	end
+	StartupTimeline.mark("first decision")
+	isReported = true
+
+	local parts = {}
+	for _, phase in ipairs(phases) do
+		table.insert(parts, string.format("%s %.1f ms", phase.name, phase.time))
+	end
+	local cached, parsed = BytecodeCache.stats()
+	log(string.format("Startup: %s (%d of %d modules from bytecode cache)", table.concat(parts, ", "),
+		cached, cached + parsed))
+	BytecodeCache.save()
+end
+
+return StartupTimeline
@@ -24,10 +24,12 @@
 local amun = amun
 local Ball = require "base/ball"
 local Constants = require "base/constants"
+local DistanceMatrix = require "base/distancematrix"
 local Robot = require "base/robot"
 local vis = require "base/vis"
 
 --- Ball and team informations.
+-- The robot lists are updated in place every frame, copy them to keep the robots of a frame.
 -- @class table
 -- @name World
 -- @field Ball Ball - current Ball
@@ -45,6 +47,7 @@ local vis = require "base/vis"
 -- @field BlueKeeper Robot - Blue keeper if on field or nil
 -- @field BlueRobotsNumberAllowed number - number of blue robots that are allowed on the field
 -- @field Robots Robot[] - Every visible robot in an arbitary order
+-- @field Distances DistanceMatrix - Distances and relative speeds between every visible robot and the ball
 -- @field TeamIsBlue bool - True if we are the blue team, otherwise we're yellow
 -- @field IsSimulated bool - True if the world is simulated
 -- @field IsLargeField bool - True if playing on the large field
@@ -81,6 +84,7 @@ World.BlueRobotsById = {}
 World.BlueKeeper = nil
 World.BlueColorStr = "<font color=\"blue\">blue</font>"
 World.Robots = {}
+World.Distances = DistanceMatrix()
 World.TeamIsBlue = false
 World.IsSimulated = false
 World.IsLargeField = false
@@ -215,6 +219,29 @@ function World._updateGeometry(geom)
 	World.IsLargeField = wgeom.FieldWidth > 5 and wgeom.FieldHeight > 7
 end
 
+-- the robot lists are reused every frame to avoid creating garbage
+local dataById = {}
+local generation = 0
+
+-- removes the entries after count without releasing the array
+local function truncate(list, count)
+	for i = #list, count + 1, -1 do
+		list[i] = nil
+	end
+end
+
+-- replaces the content of target with the entries of a followed by those of b
+local function concat(target, a, b)
+	local count = #a
+	for i = 1, count do
+		target[i] = a[i]
+	end
+	for i = 1, #b do
+		target[count + i] = b[i]
+	end
+	truncate(target, count + #b)
+end
+
 function World._updateWorld(state)
 	-- Get time
 	if World.Time then
@@ -243,66 +270,77 @@ function World._updateWorld(state)
 	local dataFriendly = World.TeamIsBlue and reality.blue_robots or reality.yellow_robots
 	if dataFriendly then
 		-- sort data by robot id
-		local dataById = {}
 		for _,rdata in ipairs(dataFriendly) do
 			dataById[rdata.id] = rdata
 		end
 
 		-- Update data of every own robot
-		World.YellowRobots = {}
-		World.YellowInvisibleRobots = {}
-		World.YellowRobotsInExchangeArea = {}
+		local robots, invisible, exchange = World.YellowRobots, World.YellowInvisibleRobots, World.YellowRobotsInExchangeArea
+		local robotCount, invisibleCount, exchangeCount = 0, 0, 0
 		for _, robot in pairs(World.YellowRobotsById) do
 			robot:_update(dataById[robot.id], World.Time)
 			-- sort robot into visible / not visible
 			if not robot.isVisible then
-				table.insert(World.YellowInvisibleRobots, robot)
+				invisibleCount = invisibleCount + 1
+				invisible[invisibleCount] = robot
 			elseif World.Geometry.GoalSubstitutionAreaPosY ~= nil and robot.pos.y < World.Geometry.GoalSubstitutionAreaPosY - Constants.maxRobotRadius then
-				table.insert(World.YellowRobotsInExchangeArea, robot)
+				exchangeCount = exchangeCount + 1
+				exchange[exchangeCount] = robot
 			else
-				table.insert(World.YellowRobots, robot)
+				robotCount = robotCount + 1
+				robots[robotCount] = robot
 			end
 		end
+		truncate(robots, robotCount)
+		truncate(invisible, invisibleCount)
+		truncate(exchange, exchangeCount)
+
+		for _,rdata in ipairs(dataFriendly) do
+			dataById[rdata.id] = nil
+		end
 	end
 
 	local dataOpponent = World.TeamIsBlue and reality.yellow_robots or reality.blue_robots
 	if dataOpponent then
-		-- only keep robots that are still existent
-		local opponentRobotsById = World.BlueRobotsById
-		World.BlueRobots = {}
-		World.BlueRobotsInExchangeArea = {}
-		World.BlueRobotsById = {}
+		-- robots that were not part of this update are tagged with an older generation
+		generation = generation + 1
+		local robotsById = World.BlueRobotsById
+		local robots, exchange = World.BlueRobots, World.BlueRobotsInExchangeArea
+		local robotCount, exchangeCount = 0, 0
 		-- just update every opponent robot
 		-- robots that are invisible for more than one second are dropped by amun
 		for _,rdata in ipairs(dataOpponent) do
-			local robot = opponentRobotsById[rdata.id]
-			opponentRobotsById[rdata.id] = nil
+			local robot = robotsById[rdata.id]
 			if not robot then
 				robot = Robot(rdata.id, false)
+				robotsById[rdata.id] = robot
 			end
+			robot._generation = generation
 			robot:_update(rdata, World.Time)
 			-- don't add robots that are in the blue goal substitution area to the BlueRobots
 			if World.Geometry.GoalSubstitutionAreaPosY ~= nil and robot.pos.y > -(World.Geometry.GoalSubstitutionAreaPosY - Constants.maxRobotRadius) then
-				table.insert(World.BlueRobotsInExchangeArea, robot)
+				exchangeCount = exchangeCount + 1
+				exchange[exchangeCount] = robot
 			else
-				table.insert(World.BlueRobots, robot)
+				robotCount = robotCount + 1
+				robots[robotCount] = robot
 			end
-			World.BlueRobotsById[rdata.id] = robot
 		end
-		-- mark dropped robots as invisible
-		for _,robot in pairs(opponentRobotsById) do
-			robot:_update(nil, World.Time)
+		truncate(robots, robotCount)
+		truncate(exchange, exchangeCount)
+		-- mark dropped robots as invisible and only keep robots that are still existent
+		for id, robot in pairs(robotsById) do
+			if robot._generation ~= generation then
+				robot:_update(nil, World.Time)
+				robotsById[id] = nil
+			end
 		end
 	end
 
-	World.YellowRobotsVisible = table.copy(World.YellowRobots)
-	table.append(World.YellowRobotsVisible, World.YellowRobotsInExchangeArea)
-
-	World.BlueRobotsVisible = table.copy(World.BlueRobots)
-	table.append(World.BlueRobotsVisible, World.BlueRobotsInExchangeArea)
-
-	World.Robots = table.copy(World.YellowRobotsVisible)
-	table.append(World.Robots, World.BlueRobotsVisible)
+	concat(World.YellowRobotsVisible, World.YellowRobots, World.YellowRobotsInExchangeArea)
+	concat(World.BlueRobotsVisible, World.BlueRobots, World.BlueRobotsInExchangeArea)
+	concat(World.Robots, World.YellowRobotsVisible, World.BlueRobotsVisible)
+	World.Distances:_update(World.Robots, World.Ball, World.Time)
 
 	-- no vision data only if the parameter is false
 	return true
@@ -0,0 +1,186 @@
+--[[
+--- Microbenchmark of the ffi based Vector against a plain table implementation
+module "VectorBenchmark"
+]]--
+
+--[[***********************************************************************
+*   Copyright 2026 Robotics Erlangen e.V.                                 *
+*   http://www.robotics-erlangen.de/                                      *
+*   info@robotics-erlangen.de                                             *
+*                                                                         *
+*   This program is free software: you can redistribute it and/or modify  *
+*   it under the terms of the GNU General Public License as published by  *
+*   the Free Software Foundation, either version 3 of the License, or     *
+*   any later version.                                                    *
+*                                                                         *
+*   This program is distributed in the hope that it will be useful,       *
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+*   GNU General Public License for more details.                          *
+*                                                                         *
+*   You should have received a copy of the GNU General Public License     *
+*   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+*************************************************************************]]
+
+
+local VectorBenchmark = {}
+
+local amun = amun
+local debug = require "base/debug"
+local World = require "base/world"
+
+local REPETITIONS = 50 -- workload runs per frame and implementation
+
+local sqrt, cos, sin = math.sqrt, math.cos, math.sin
+
+-- Reference implementation which stores every vector in a Lua table,
+-- as the Vector class did before it was moved to ffi. Only the functions
+-- used by the workload are implemented.
+local TableVector = {}
+local tableVector_mt = {}
+local tableMt = {
+	__add = function(a, b) return TableVector(a.x+b.x, a.y+b.y) end,
+	__sub = function(a, b) return TableVector(a.x-b.x, a.y-b.y) end,
+	__mul = function(a, b) return TableVector(a.x*b, a.y*b) end,
+	__index = tableVector_mt,
+}
+setmetatable(TableVector, {
+	__call = function(_, x, y)
+		return setmetatable({x = x, y = y}, tableMt)
+	end
+})
+
+function tableVector_mt:copy()
+	return TableVector(self.x, self.y)
+end
+
+function tableVector_mt:length()
+	return sqrt(self.x * self.x + self.y * self.y)
+end
+
+function tableVector_mt:lengthSq()
+	return self.x * self.x + self.y * self.y
+end
+
+function tableVector_mt:normalize()
+	local l = self:length()
+	if l > 0 then
+		self.x = self.x / l
+		self.y = self.y / l
+	end
+	return self
+end
+
+function tableVector_mt:dot(other)
+	return self.x * other.x + self.y * other.y
+end
+
+function tableVector_mt:perpendicular()
+	return TableVector(self.y, -self.x)
+end
+
+function tableVector_mt:distanceTo(other)
+	return (other - self):length()
+end
+
+function tableVector_mt:rotate(angle)
+	local x, y = self.x, self.y
+	self.x = cos(angle) * x - sin(angle) * y
+	self.y = sin(angle) * x + cos(angle) * y
+	return self
+end
+
+function tableVector_mt:orthogonalProjection(linePoint1, linePoint2)
+	local rv = linePoint2 - linePoint1
+	if rv:lengthSq() < 0.00001 * 0.00001 then
+		return linePoint1, self:distanceTo(linePoint1)
+	end
+	local normal = rv:perpendicular()
+	local t = normal:dot(linePoint1 - self) / normal:dot(normal)
+	return self + normal * t, t * rv:length()
+end
+
+function tableVector_mt:distanceToLineSegment(lineStart, lineEnd)
+	local dir = (lineEnd - lineStart):normalize()
+	local d = self - lineStart
+	if d:dot(dir) < 0 then
+		return d:length()
+	end
+	d = self - lineEnd
+	if d:dot(dir) > 0 then
+		return d:length()
+	end
+	return math.abs(d.x * dir.y - d.y * dir.x)
+end
+
+-- Mix of the vector operations done by the rules for every robot:
+-- pairwise distances as in the collision rule, projections onto the
+-- line from the ball to the goal and the distance of the robot front to it
+local function ruleWorkload(create, xs, ys, count, ballX, ballY, goalY)
+	local ball = create(ballX, ballY)
+	local goal = create(0, goalY)
+	local result = 0
+	for i = 1, count do
+		local pos = create(xs[i], ys[i])
+		for j = i + 1, count do
+			local other = create(xs[j], ys[j])
+			if (pos - other):length() < 0.5 then
+				result = result + pos:distanceTo(other)
+			end
+		end
+		local projected, dist = pos:orthogonalProjection(ball, goal)
+		result = result + dist + (projected - pos):lengthSq()
+		local dir = (ball - pos):normalize()
+		result = result + (pos + dir * 0.09):distanceToLineSegment(ball, goal)
+		result = result + pos:copy():rotate(0.1):dot(dir)
+	end
+	return result
+end
+
+-- run the workload with garbage collection stopped to measure all allocations
+local function measure(create, xs, ys, count, ballX, ballY, goalY)
+	collectgarbage("stop")
+	local startMemory = collectgarbage("count")
+	local startTime = amun.getCurrentTime()
+	local result = 0
+	for _ = 1, REPETITIONS do
+		result = result + ruleWorkload(create, xs, ys, count, ballX, ballY, goalY)
+	end
+	local duration = amun.getCurrentTime() - startTime
+	local allocated = (collectgarbage("count") - startMemory) * 1024
+	collectgarbage("restart")
+	return duration, allocated, result
+end
+
+local xs = {}
+local ys = {}
+
+--- Runs the workload on the robots of the current frame with both implementations
+-- and publishes the time and memory per run below "Vector benchmark"
+-- @name run
+function VectorBenchmark.run()
+	local count = 0
+	for _, robot in ipairs(World.Robots) do
+		count = count + 1
+		xs[count] = robot.pos.x
+		ys[count] = robot.pos.y
+	end
+	local ballX, ballY = World.Ball.pos.x, World.Ball.pos.y
+	local goalY = World.Geometry.FieldHeightHalf
+
+	local tableTime, tableAllocated, tableResult = measure(TableVector, xs, ys, count, ballX, ballY, goalY)
+	local ffiTime, ffiAllocated, ffiResult = measure(Vector, xs, ys, count, ballX, ballY, goalY)
+
+	debug.pushtop("Vector benchmark")
+	debug.set("robots", count)
+	debug.set("table/time [ms]", tableTime * 1000 / REPETITIONS)
+	debug.set("table/allocated [B]", tableAllocated / REPETITIONS)
+	debug.set("ffi/time [ms]", ffiTime * 1000 / REPETITIONS)
+	debug.set("ffi/allocated [B]", ffiAllocated / REPETITIONS)
+	debug.set("speedup", ffiTime > 0 and tableTime / ffiTime or 0)
+	-- both implementations have to agree, up to rounding
+	debug.set("result difference", math.abs(tableResult - ffiResult) / REPETITIONS)
+	debug.pop()
+end
+
+return VectorBenchmark
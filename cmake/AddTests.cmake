@@ -1,6 +1,9 @@
 add_test(NAME luacheck-autoref
     COMMAND luacheck -q .
     WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}/autoref")
+add_test(NAME distance-matrix
+    COMMAND luajit ${CMAKE_SOURCE_DIR}/cmake/distancematrixtest.lua
+    WORKING_DIRECTORY "${CMAKE_SOURCE_DIR}/autoref")
 
 # show what went wrong by default
 add_custom_target(check COMMAND ${CMAKE_CTEST_COMMAND} --output-on-failure
@@ -17,3 +20,14 @@ add_custom_command(
     COMMAND ${CMAKE_COMMAND} -E copy ${CMAKE_SOURCE_DIR}/cmake/autoreftesthelper.lua ${CMAKE_BINARY_DIR}/autoreftesthelper.lua
     DEPENDS ${CMAKE_SOURCE_DIR}/cmake/autoreftesthelper.lua
 )
+
+# replays a log against cmake/mock_game_controller.py, which has to be free to listen on port 10007,
+# the autoref must detect at least one foul in the log. No log is shipped, thus the test is opt-in
+set(AUTOREF_GAME_CONTROLLER_TEST_LOG "" CACHE FILEPATH "Log replayed by the game controller connection test, the test is skipped if unset")
+if(AUTOREF_GAME_CONTROLLER_TEST_LOG)
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+    add_test(NAME game-controller-connection
+        COMMAND ${Python3_EXECUTABLE} ${CMAKE_SOURCE_DIR}/cmake/run_game_controller_test.py
+            $<TARGET_FILE:autoref-cli> ${AUTOREF_GAME_CONTROLLER_TEST_LOG}
+        WORKING_DIRECTORY ${CMAKE_BINARY_DIR})
+endif()
@@ -0,0 +1,166 @@
+-- Tests the swept contact detection of the distance matrix, including a fast
+-- robot that passes through a slow one between two frames.
+-- Runs with plain LuaJIT and needs neither amun nor a log.
+-- Usage: luajit distancematrixtest.lua
+
+-- the autoref modules are located next to this directory
+local testDir = arg and arg[0] and arg[0]:match("^(.*)/[^/]*$") or "."
+package.path = testDir .. "/../autoref/?.lua;" .. package.path
+
+local DistanceMatrix = require "base/distancematrix"
+
+local FRAME_TIME = 0.05 -- s
+local CONTACT_DISTANCE = 0.18 -- m, twice the maximum robot radius
+local EPSILON = 1e-6
+
+local vectorMethods = {
+	length = function(v) return math.sqrt(v.x * v.x + v.y * v.y) end
+}
+local function vector(x, y)
+	return setmetatable({x = x, y = y}, {__index = vectorMethods})
+end
+
+local ball = {pos = vector(2, 2), speed = vector(0, 0)}
+
+local function robot(x, speedX)
+	return {pos = vector(x, 0), speed = vector(speedX, 0)}
+end
+
+local function move(r, x, speedX)
+	r.pos = vector(x, 0)
+	r.speed = vector(speedX, 0)
+end
+
+local function expectNear(name, expected, actual)
+	if actual == nil or math.abs(expected - actual) > EPSILON then
+		error(name .. ": expected " .. expected .. " but got " .. tostring(actual), 2)
+	end
+end
+
+local function expectNoContact(name, distances, i, j)
+	local time = distances:sweptContactByIndex(i, j, CONTACT_DISTANCE)
+	if time ~= nil then
+		error(name .. ": expected no contact but got one at " .. time, 2)
+	end
+end
+
+local tests = {}
+
+function tests.passThrough()
+	-- the fast robot is 0.45 m behind the slow one and 0.3 m in front of it one frame later,
+	-- thus both never touch at a tracked frame
+	local fast, slow = robot(-0.3, 14), robot(0.15, -1)
+	local distances = DistanceMatrix()
+	distances:_update({fast, slow}, ball, 0)
+	expectNoContact("first frame", distances, 1, 2)
+	move(fast, 0.4, 14)
+	move(slow, 0.1, -1)
+	distances:_update({fast, slow}, ball, FRAME_TIME)
+	if distances:distanceByIndex(1, 2) <= CONTACT_DISTANCE then
+		error("The robots touch in the second frame, the test does not cover a pass through")
+	end
+
+	local time, impactSpeed, fastSpeed, slowSpeed, s = distances:sweptContactByIndex(1, 2, CONTACT_DISTANCE)
+	-- the gap of 0.45 m closes at 0.75 m per frame until it is 0.18 m
+	expectNear("fraction", (0.45 - CONTACT_DISTANCE) / 0.75, s)
+	expectNear("time", s * FRAME_TIME, time)
+	expectNear("impact speed", 15, impactSpeed)
+	expectNear("speed of the fast robot", 14, fastSpeed)
+	expectNear("speed of the slow robot", 1, slowSpeed)
+
+	local fastX = distances:positionAt(1, s)
+	local slowX = distances:positionAt(2, s)
+	expectNear("distance at impact", CONTACT_DISTANCE, slowX - fastX)
+	local fastVelX = distances:velocityAt(1, s)
+	local slowVelX = distances:velocityAt(2, s)
+	expectNear("speed difference at impact", 15, fastVelX - slowVelX)
+end
+
+function tests.interpolatedVelocities()
+	-- the robot brakes from 4 to 2 m/s, thus it is at 3 m/s halfway through the frame
+	local moving, standing = robot(0, 4), robot(0.28, 0)
+	local distances = DistanceMatrix()
+	distances:_update({moving, standing}, ball, 0)
+	move(moving, 0.2, 2)
+	distances:_update({moving, standing}, ball, FRAME_TIME)
+
+	local _, impactSpeed, movingSpeed, _, s = distances:sweptContactByIndex(1, 2, CONTACT_DISTANCE)
+	expectNear("fraction", 0.5, s)
+	expectNear("impact speed", 3, impactSpeed)
+	expectNear("speed of the moving robot", 3, movingSpeed)
+end
+
+function tests.missedRobots()
+	local first, second = robot(0, 1), robot(1, 1)
+	local distances = DistanceMatrix()
+	distances:_update({first, second}, ball, 0)
+	move(first, 0.05, 1)
+	move(second, 1.05, 1)
+	distances:_update({first, second}, ball, FRAME_TIME)
+	expectNoContact("parallel robots", distances, 1, 2)
+end
+
+function tests.withoutPreviousFrame()
+	-- a robot that just appeared is only checked at its current position
+	local first, second = robot(0, 2), robot(0.2, -1)
+	local distances = DistanceMatrix()
+	distances:_update({first}, ball, 0)
+	move(first, 0.1, 2)
+	distances:_update({first, second}, ball, FRAME_TIME)
+
+	local time, impactSpeed, firstSpeed, secondSpeed, s = distances:sweptContactByIndex(1, 2, CONTACT_DISTANCE)
+	expectNear("time", FRAME_TIME, time)
+	expectNear("fraction", 1, s)
+	expectNear("impact speed", 3, impactSpeed)
+	expectNear("speed of the first robot", 2, firstSpeed)
+	expectNear("speed of the new robot", 1, secondSpeed)
+end
+
+function tests.continuedContact()
+	-- robots that already touched are only reported with the values of the current frame
+	local first, second = robot(0, 3), robot(0.1, 0)
+	local distances = DistanceMatrix()
+	distances:_update({first, second}, ball, 0)
+	move(first, 0.05, 1)
+	move(second, 0.15, 1)
+	distances:_update({first, second}, ball, FRAME_TIME)
+	local time, impactSpeed, firstSpeed, _, s = distances:sweptContactByIndex(1, 2, CONTACT_DISTANCE)
+	expectNear("time", FRAME_TIME, time)
+	expectNear("fraction", 1, s)
+	expectNear("impact speed", 0, impactSpeed)
+	expectNear("speed of the first robot", 1, firstSpeed)
+
+	move(second, 0.5, 1)
+	distances:_update({first, second}, ball, 2 * FRAME_TIME)
+	expectNoContact("separated robots", distances, 1, 2)
+end
+
+function tests.longGap()
+	-- after a gap in the vision data the robots are not swept
+	local fast, slow = robot(-0.3, 14), robot(0.15, -1)
+	local distances = DistanceMatrix()
+	distances:_update({fast, slow}, ball, 0)
+	move(fast, 0.4, 14)
+	move(slow, 0.1, -1)
+	distances:_update({fast, slow}, ball, 1)
+	expectNoContact("long gap", distances, 1, 2)
+end
+
+local names = {}
+for name in pairs(tests) do
+	table.insert(names, name)
+end
+table.sort(names)
+local failed = 0
+for _, name in ipairs(names) do
+	local ok, err = pcall(tests[name])
+	if ok then
+		print("PASS " .. name)
+	else
+		print("FAIL " .. name .. ": " .. tostring(err))
+		failed = failed + 1
+	end
+end
+if failed > 0 then
+	os.exit(1)
+end
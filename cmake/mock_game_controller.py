@@ -0,0 +1,108 @@
+#!/usr/bin/python3
+
+# Minimal stand-in for the autoref interface of the ssl game controller.
+# Every message of the autoref is answered with an OK reply and logged with
+# its receive time, which allows testing the connection handling of the
+# autoref without a running game controller.
+
+import argparse
+import socket
+import socketserver
+import sys
+import threading
+import time
+
+# ControllerToAutoRef { controller_reply { status_code: OK } }
+REPLY_OK = bytes([0x0a, 0x02, 0x08, 0x01])
+
+statistics = {"connections": 0, "messages": 0, "bytes": 0}
+statisticsLock = threading.Lock()
+
+def encodeVarint(value):
+	result = bytearray()
+	while True:
+		byte = value & 0x7f
+		value >>= 7
+		if value:
+			result.append(byte | 0x80)
+		else:
+			result.append(byte)
+			return bytes(result)
+
+def readVarint(stream):
+	value = 0
+	shift = 0
+	while True:
+		byte = stream.read(1)
+		if not byte:
+			return None
+		value |= (byte[0] & 0x7f) << shift
+		if not byte[0] & 0x80:
+			return value
+		shift += 7
+
+def sendReply(stream):
+	stream.write(encodeVarint(len(REPLY_OK)) + REPLY_OK)
+	stream.flush()
+
+class AutorefHandler(socketserver.StreamRequestHandler):
+	def handle(self):
+		with statisticsLock:
+			statistics["connections"] += 1
+			connection = statistics["connections"]
+		print("%.6f connection %d from %s:%d" % (time.time(), connection, *self.client_address[:2]), flush=True)
+		# the game controller greets a new autoref with a reply
+		sendReply(self.wfile)
+
+		received = 0
+		while True:
+			length = readVarint(self.rfile)
+			if length is None:
+				break
+			message = self.rfile.read(length)
+			if len(message) < length:
+				break
+			received += 1
+			with statisticsLock:
+				statistics["messages"] += 1
+				statistics["bytes"] += length
+			print("%.6f connection %d message %d with %d bytes" % (time.time(), connection, received, length), flush=True)
+
+			if self.server.replyDelay > 0:
+				time.sleep(self.server.replyDelay)
+			sendReply(self.wfile)
+			if self.server.disconnectAfter > 0 and received >= self.server.disconnectAfter:
+				print("%.6f connection %d closed after %d messages" % (time.time(), connection, received), flush=True)
+				self.request.shutdown(socket.SHUT_RDWR)
+				return
+		print("%.6f connection %d closed by the autoref" % (time.time(), connection), flush=True)
+
+class MockGameController(socketserver.ThreadingTCPServer):
+	allow_reuse_address = True
+	daemon_threads = True
+
+def main():
+	parser = argparse.ArgumentParser(description="Mock of the autoref interface of the ssl game controller")
+	parser.add_argument("--port", type=int, default=10007, help="port the autoref connects to (default 10007)")
+	parser.add_argument("--disconnect-after", type=int, default=0, metavar="N",
+		help="close each connection after N messages to test reconnects")
+	parser.add_argument("--reply-delay", type=float, default=0, metavar="SECONDS",
+		help="delay every reply to simulate a slow game controller")
+	args = parser.parse_args()
+
+	server = MockGameController(("", args.port), AutorefHandler)
+	server.disconnectAfter = args.disconnect_after
+	server.replyDelay = args.reply_delay
+	print("Listening on port %d" % args.port, flush=True)
+	try:
+		server.serve_forever()
+	except KeyboardInterrupt:
+		pass
+	finally:
+		server.server_close()
+		with statisticsLock:
+			print("%d connections, %d messages, %d bytes" % (statistics["connections"], statistics["messages"], statistics["bytes"]))
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main())
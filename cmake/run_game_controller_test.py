@@ -0,0 +1,74 @@
+#!/usr/bin/python3
+
+# Replays a log with autoref-cli and sends its game events to the mock game
+# controller. Fails unless the autoref registered itself and the mock
+# received exactly the game events the autoref reported as sent.
+
+import os
+import re
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+if len(sys.argv) != 3:
+	print("Usage: python3 run_game_controller_test.py <autoref-cli binary> <log file>")
+	exit(1)
+
+mockScript = os.path.join(os.path.dirname(os.path.abspath(__file__)), "mock_game_controller.py")
+# the mock logs every message, a pipe could fill up and block it
+mockLog = tempfile.TemporaryFile("w+")
+mock = subprocess.Popen([sys.executable, mockScript], stdout=mockLog, stderr=subprocess.STDOUT, universal_newlines=True)
+for _ in range(50):
+	mockLog.seek(0)
+	if mockLog.readline().startswith("Listening"):
+		break
+	time.sleep(0.1)
+else:
+	mock.kill()
+	print("Could not start the mock game controller")
+	exit(1)
+
+result = subprocess.run([sys.argv[1], "--replay", sys.argv[2], "--replay-game-controller", "127.0.0.1"],
+	stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+mock.send_signal(signal.SIGINT)
+mock.wait()
+mockLog.seek(0)
+mockOutput = mockLog.read()
+
+if result.returncode != 0:
+	print(result.stdout)
+	print(result.stderr)
+	print("autoref-cli failed with exit code " + str(result.returncode))
+	exit(1)
+
+match = re.search(r"^(\d+) connections, (\d+) messages", mockOutput, re.MULTILINE)
+if not match:
+	print(mockOutput)
+	print("The mock game controller did not report its statistics")
+	exit(1)
+connections = int(match.group(1))
+messages = int(match.group(2))
+# the registration is the first message of every connection
+if connections == 0 or messages < connections:
+	print(mockOutput)
+	print("The autoref did not register at the game controller")
+	exit(1)
+receivedEvents = messages - connections
+
+sentMatch = re.search(r"Sent (\d+) game events to the game controller", result.stdout + result.stderr)
+if not sentMatch:
+	print(result.stdout)
+	print(result.stderr)
+	print("autoref-cli did not report the number of sent game events")
+	exit(1)
+sentEvents = int(sentMatch.group(1))
+if sentEvents == 0:
+	print("The replayed log contains no game events, use a log in which the autoref detects fouls")
+	exit(1)
+if receivedEvents != sentEvents:
+	print(mockOutput)
+	print("The autoref sent %d game events, but the game controller received %d" % (sentEvents, receivedEvents))
+	exit(1)
+print("Game controller received %d game events in %d connections" % (receivedEvents, connections))
@@ -28,10 +28,26 @@
 #include "protobuf/ssl_vision/ssl_geometry.pb.h"
 #include "protobuf/world.pb.h"
 #include "strategy/strategy.h"
+#include "allocationcounter.h"
+#include "amunthreadpool.h"
+#include "latencystatistics.h"
+#include "statusbus.h"
+#include "threadtopology.h"
 #include "networkinterfacewatcher.h"
 #include "visiontrackedpublisher.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
 #include <QMetaType>
 #include <QThread>
+#include <QTimer>
+#include <QtGlobal>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include "batchedreceiver.h"
+#endif
 
 /*!
  * \class Amun
@@ -48,11 +64,22 @@
  */
 
 /*!
- * \brief Creates an Amun instance
+ * \brief Creates an Amun instance with the default options
  * \param parent Parent object
  */
 Amun::Amun(bool simulatorOnly, QObject *parent) :
-    QObject(parent)
+    Amun(simulatorOnly, AmunOptions::getDefault(), parent)
+{
+}
+
+/*!
+ * \brief Creates an Amun instance
+ * \param options Startup configuration of this instance
+ * \param parent Parent object
+ */
+Amun::Amun(bool simulatorOnly, const AmunOptions &options, QObject *parent) :
+    QObject(parent),
+    m_options(options)
 {
     qRegisterMetaType<QNetworkInterface>("QNetworkInterface");
     qRegisterMetaType<Command>("Command");
@@ -65,13 +92,45 @@ Amun::Amun(bool simulatorOnly, QObject *parent) :
 
     // global timer, which can be slowed down / sped up
     m_timer = new Timer;
-    // these threads just run an event loop
-    // using the signal-slot mechanism the objects in these can be called
-    m_processorThread = new QThread(this);
-    m_networkThread = new QThread(this);
-    m_autorefThread = new QThread(this);
+    m_threadTopology.reset(new ThreadTopology(m_options.isolatedCpus));
+    if (m_options.threadPool) {
+        // the processor does not wait for the strategy of the same field, the pool is already running
+        m_processorThread = m_options.threadPool->processorWorker(m_options.instance);
+        m_autorefThread = m_options.threadPool->strategyWorker(m_options.instance);
+        m_networkThread = m_options.threadPool->networkThread();
+        m_networkEngineThread = m_options.threadPool->networkEngineThread();
+    } else {
+        // these threads just run an event loop
+        // using the signal-slot mechanism the objects in these can be called
+        m_processorThread = new QThread(this);
+        m_networkThread = new QThread(this);
+        m_autorefThread = new QThread(this);
+#ifdef Q_OS_LINUX
+        if (m_options.networkBackend == AmunOptions::NetworkBackend::Batched) {
+            // receiving runs separately from the tracker publishing, so that a
+            // burst of vision packets is never queued behind outgoing frames
+            m_networkEngineThread = new QThread(this);
+        }
+#endif
+
+        m_threadTopology->manage(m_processorThread, "processor", m_options.processorThread);
+        m_threadTopology->manage(m_networkThread, "network", m_options.networkThread);
+        m_threadTopology->manage(m_autorefThread, "autoref", m_options.autorefThread);
+        if (m_networkEngineThread) {
+            m_threadTopology->manage(m_networkEngineThread, "network-engine", m_options.networkEngineThread);
+        }
+    }
 
     m_networkInterfaceWatcher = new NetworkInterfaceWatcher(this);
+    m_statusBus = new StatusBus(m_timer, this);
+    m_strategyStatusBus = new StatusBus(m_timer, this);
+    m_latency.reset(new LatencyStatistics);
+
+    // editors tend to write several files at once, reload after the last one
+    m_reloadDelay = new QTimer(this);
+    m_reloadDelay->setSingleShot(true);
+    m_reloadDelay->setInterval(200);
+    connect(m_reloadDelay, &QTimer::timeout, this, &Amun::startBackgroundReload);
 }
 
 /*!
@@ -109,6 +168,10 @@ void Amun::start()
     m_gameControllerConnection->switchInternalGameController(false);
     m_gameControllerConnection->moveToThread(m_autorefThread);
     connect(m_processor, &Processor::refereeHostChanged, m_gameControllerConnection.get(), &StrategyGameControllerMediator::handleExternalRefereeHost);
+    // passed to the game controller connection of a strategy started by a background reload
+    connect(m_processor, &Processor::refereeHostChanged, this, [this](const QString &host) {
+        m_refereeHost = host;
+    });
 
     // start strategy threads
     Q_ASSERT(m_autoref == nullptr);
@@ -117,76 +180,200 @@ void Amun::start()
     connect(m_autorefThread, SIGNAL(finished()), m_autoref, SLOT(deleteLater()));
 
 
+    const StatusBus::Delivery delivery = m_options.latestWinsDelivery ?
+                StatusBus::Delivery::LatestWins : StatusBus::Delivery::Queued;
+
     // send tracking, geometry and referee to strategy
-    connect(m_processor, SIGNAL(sendStrategyStatus(Status)),
-            m_autoref, SLOT(handleStatus(Status)));
-    connect(m_optionsManager, &OptionsManager::sendStatus, m_autoref, &Strategy::handleStatus);
-    // route commands from and to strategy
-    connect(m_autoref, SIGNAL(gotCommand(Command)), SLOT(handleCommand(Command)));
-    connect(this, SIGNAL(gotCommand(Command)),
-            m_autoref, SLOT(handleCommand(Command)));
-    // relay status and debug information of strategy
-    connect(m_autoref, SIGNAL(sendStatus(Status)), SLOT(handleStatus(Status)));
-    connect(m_autoref, &Strategy::sendStatus, m_optionsManager, &OptionsManager::handleStatus);
-    connect(m_processor, SIGNAL(setFlipped(bool)), m_autoref, SLOT(setFlipped(bool)));
-    m_autoref->setFlipped(m_processor->getIsFlipped());
+    // the bus is fed directly from the processor thread to avoid another hop
+    m_strategyStatusBus->subscribe("autoref", StatusBus::All, m_autoref, &Strategy::handleStatus, delivery);
+    connect(m_processor, &Processor::sendStrategyStatus, m_strategyStatusBus, &StatusBus::publish, Qt::DirectConnection);
+    connectAutorefInputs(m_autoref);
+    connectAutorefOutputs(m_autoref);
 
-    // create referee
-    setupReceiver(m_referee, QHostAddress(SSL_GAME_CONTROLLER_ADDRESS), SSL_GAME_CONTROLLER_PORT);
-    connect(this, &Amun::updateRefereePort, m_referee, &Receiver::updatePort);
-    // move referee packets to processor
-    connect(m_referee, &Receiver::gotPacket, m_processor, &Processor::handleRefereePacket);
+    setupNetwork();
 
-    // create vision
-    setupReceiver(m_vision, QHostAddress(SSL_VISION_ADDRESS), SSL_VISION_PORT);
-    // allow updating the port used to listen for ssl vision
-    connect(this, &Amun::updateVisionPort, m_vision, &Receiver::updatePort);
-    // connect
-    connect(m_vision, SIGNAL(gotPacket(QByteArray, qint64, QString)),
-            m_processor, SLOT(handleVisionPacket(QByteArray, qint64, QString)));
-    connect(m_vision, &Receiver::sendStatus, this, &Amun::handleStatus);
-
-    m_visionPublisher = new VisionTrackedPublisher();
+    m_visionPublisher = new VisionTrackedPublisher(m_timer);
     m_visionPublisher->moveToThread(m_networkThread);
     connect(m_networkThread, SIGNAL(finished()), m_visionPublisher, SLOT(deleteLater()));
     connect(m_processor, &Processor::setFlipped, m_visionPublisher, &VisionTrackedPublisher::setFlip);
-    connect(this, &Amun::sendStatus, m_visionPublisher, &VisionTrackedPublisher::handleStatus);
+    m_statusBus->subscribe("tracker publisher", StatusBus::WorldState, m_visionPublisher, &VisionTrackedPublisher::handleStatus, delivery);
+    connect(m_visionPublisher, &VisionTrackedPublisher::sendStatus, this, &Amun::handleStatus);
     connect(this, &Amun::updateTrackerPort, m_visionPublisher, &VisionTrackedPublisher::updatePort);
 
+    // threads of a pool are already running
+    if (m_options.threadPool) {
+        for (QObject *receiver : std::initializer_list<QObject *>{ m_referee, m_vision, m_batchedReferee, m_batchedVision }) {
+            if (receiver) {
+                QMetaObject::invokeMethod(receiver, "startListen", Qt::QueuedConnection);
+            }
+        }
+        return;
+    }
+
     // start threads
     m_processorThread->start();
     m_networkThread->start();
+    if (m_networkEngineThread) {
+        m_networkEngineThread->start();
+    }
     m_autorefThread->start();
 }
 
+/*!
+ * \brief Passes the options and the field orientation to the strategy
+ */
+void Amun::connectAutorefInputs(Strategy *strategy)
+{
+    connect(m_optionsManager, &OptionsManager::sendStatus, strategy, &Strategy::handleStatus);
+    connect(strategy, &Strategy::sendStatus, m_optionsManager, &OptionsManager::handleStatus);
+    connect(m_processor, SIGNAL(setFlipped(bool)), strategy, SLOT(setFlipped(bool)));
+    strategy->setFlipped(m_processor->getIsFlipped());
+}
+
+/*!
+ * \brief Routes the commands and the status of the strategy
+ */
+void Amun::connectAutorefOutputs(Strategy *strategy)
+{
+    // route commands from and to strategy
+    connect(strategy, SIGNAL(gotCommand(Command)), SLOT(handleCommand(Command)));
+    connect(this, SIGNAL(gotCommand(Command)),
+            strategy, SLOT(handleCommand(Command)));
+    // relay status and debug information of strategy
+    connect(strategy, SIGNAL(sendStatus(Status)), SLOT(handleStatus(Status)));
+}
+
+// deletes an object living in another, running thread
+static void deleteInThread(QObject *object)
+{
+    if (object) {
+        QMetaObject::invokeMethod(object, [object]() { delete object; }, Qt::BlockingQueuedConnection);
+    }
+}
+
 /*!
  * \brief Stop processing
  *
- * All threads are stopped.
+ * All threads are stopped. Threads of a thread pool keep running, the
+ * objects of this instance are deleted in them instead.
  */
 void Amun::stop()
+{
+    if (m_options.threadPool) {
+        // the threads keep running for the other instances
+        m_statusBus->unsubscribe(m_visionPublisher);
+        m_strategyStatusBus->unsubscribe(m_autoref);
+        deleteInThread(m_autoref);
+        deleteInThread(m_processor);
+        if (m_gameControllerConnection) {
+            QMetaObject::invokeMethod(m_gameControllerConnection.get(), [this]() {
+                m_gameControllerConnection.reset();
+            }, Qt::BlockingQueuedConnection);
+        }
+        deleteInThread(m_vision);
+        deleteInThread(m_referee);
+        deleteInThread(m_batchedVision);
+        deleteInThread(m_batchedReferee);
+        deleteInThread(m_visionPublisher);
+    } else {
+        abortBackgroundReload(QString());
+        stopThreads();
+    }
+
+    delete m_optionsManager;
+
+    // worker objects are destroyed on thread shutdown
+    m_vision = nullptr;
+    m_referee = nullptr;
+    m_batchedVision = nullptr;
+    m_batchedReferee = nullptr;
+    m_autoref = nullptr;
+    m_processor = nullptr;
+    m_optionsManager = nullptr;
+    m_visionPublisher = nullptr;
+}
+
+void Amun::stopThreads()
 {
     // stop threads
     m_processorThread->quit();
     m_networkThread->quit();
     m_autorefThread->quit();
+    if (m_networkEngineThread) {
+        m_networkEngineThread->quit();
+    }
 
     // wait for threads
     m_processorThread->wait();
     m_networkThread->wait();
     m_autorefThread->wait();
+    if (m_networkEngineThread) {
+        m_networkEngineThread->wait();
+    }
 
-    delete m_optionsManager;
+    m_statusBus->unsubscribe(m_visionPublisher);
+    m_strategyStatusBus->unsubscribe(m_autoref);
+}
 
-    // worker objects are destroyed on thread shutdown
-    m_vision = nullptr;
-    m_referee = nullptr;
-    m_autoref = nullptr;
-    m_processor = nullptr;
-    m_optionsManager = nullptr;
-    m_visionPublisher = nullptr;
+void Amun::setupNetwork()
+{
+#ifdef Q_OS_LINUX
+    if (m_networkEngineThread) {
+        // create referee
+        setupBatchedReceiver(m_batchedReferee, QHostAddress(SSL_GAME_CONTROLLER_ADDRESS), SSL_GAME_CONTROLLER_PORT);
+        connect(this, &Amun::updateRefereePort, m_batchedReferee, &BatchedReceiver::updatePort);
+        connect(m_batchedReferee, &BatchedReceiver::gotPacket, m_processor, &Processor::handleRefereePacket);
+
+        // create vision
+        setupBatchedReceiver(m_batchedVision, QHostAddress(SSL_VISION_ADDRESS), SSL_VISION_PORT);
+        connect(this, &Amun::updateVisionPort, m_batchedVision, &BatchedReceiver::updatePort);
+        connect(m_batchedVision, SIGNAL(gotPacket(QByteArray, qint64, QString)),
+                m_processor, SLOT(handleVisionPacket(QByteArray, qint64, QString)));
+        connect(m_batchedVision, &BatchedReceiver::sendStatus, this, &Amun::handleStatus);
+        connect(m_batchedVision, &BatchedReceiver::gotPacket, this, [this](const QByteArray &, qint64 time) {
+            addVisionPacketTime(time);
+        }, Qt::DirectConnection);
+        return;
+    }
+#endif
+
+    // create referee
+    setupReceiver(m_referee, QHostAddress(SSL_GAME_CONTROLLER_ADDRESS), SSL_GAME_CONTROLLER_PORT);
+    connect(this, &Amun::updateRefereePort, m_referee, &Receiver::updatePort);
+    // move referee packets to processor
+    connect(m_referee, &Receiver::gotPacket, m_processor, &Processor::handleRefereePacket);
+
+    // create vision
+    setupReceiver(m_vision, QHostAddress(SSL_VISION_ADDRESS), SSL_VISION_PORT);
+    // allow updating the port used to listen for ssl vision
+    connect(this, &Amun::updateVisionPort, m_vision, &Receiver::updatePort);
+    // connect
+    connect(m_vision, SIGNAL(gotPacket(QByteArray, qint64, QString)),
+            m_processor, SLOT(handleVisionPacket(QByteArray, qint64, QString)));
+    connect(m_vision, &Receiver::sendStatus, this, &Amun::handleStatus);
+    // remember the receive time on the network thread to measure the tracking latency
+    connect(m_vision, &Receiver::gotPacket, this, [this](const QByteArray &, qint64 time) {
+        addVisionPacketTime(time);
+    }, Qt::DirectConnection);
 }
 
+#ifdef Q_OS_LINUX
+void Amun::setupBatchedReceiver(BatchedReceiver *&receiver, const QHostAddress &address, quint16 port)
+{
+    Q_ASSERT(receiver == nullptr);
+    receiver = new BatchedReceiver(address, port, m_timer);
+    receiver->moveToThread(m_networkEngineThread);
+    connect(m_networkEngineThread, SIGNAL(finished()), receiver, SLOT(deleteLater()));
+    connect(m_networkEngineThread, SIGNAL(started()), receiver, SLOT(startListen()));
+    connect(m_networkInterfaceWatcher, &NetworkInterfaceWatcher::interfaceUpdated, receiver, &BatchedReceiver::updateInterface);
+}
+#else
+void Amun::setupBatchedReceiver(BatchedReceiver *&, const QHostAddress &, quint16)
+{
+    Q_UNREACHABLE();
+}
+#endif
+
 void Amun::setupReceiver(Receiver *&receiver, const QHostAddress &address, quint16 port)
 {
     Q_ASSERT(receiver == nullptr);
@@ -217,9 +404,251 @@ void Amun::handleCommand(const Command &command)
         }
     }
 
+    if (m_options.backgroundReload && !m_options.threadPool && command->has_strategy_autoref()
+            && handleBackgroundReload(command)) {
+        return;
+    }
+
     emit gotCommand(command);
 }
 
+/*!
+ * \brief Takes over reloading the autoref from the strategy
+ *
+ * Remembers the load command and replaces manual and automatic reloads of the
+ * strategy by a background reload.
+ * \return true if the command was already passed on
+ */
+bool Amun::handleBackgroundReload(const Command &command)
+{
+    const amun::CommandStrategy &strategy = command->strategy_autoref();
+    if (strategy.has_load()) {
+        *m_autorefCommand.mutable_load() = strategy.load();
+        abortBackgroundReload("Background reload aborted, another strategy was loaded");
+        updateReloadWatcher();
+    }
+    if (strategy.has_enable_debug()) {
+        m_autorefCommand.set_enable_debug(strategy.enable_debug());
+    }
+    if (strategy.has_close()) {
+        m_autorefCommand.Clear();
+        abortBackgroundReload("Background reload aborted, the strategy was closed");
+        updateReloadWatcher();
+    }
+    if (strategy.has_auto_reload()) {
+        m_autoReload = strategy.auto_reload();
+        updateReloadWatcher();
+    }
+
+    if (!strategy.reload() && !strategy.has_auto_reload()) {
+        return false;
+    }
+    // the strategy itself must never reload, pass on everything else
+    Command forwarded(new amun::Command(*command));
+    forwarded->mutable_strategy_autoref()->clear_reload();
+    forwarded->mutable_strategy_autoref()->clear_auto_reload();
+    emit gotCommand(forwarded);
+
+    if (strategy.reload()) {
+        startBackgroundReload();
+    }
+    return true;
+}
+
+/*!
+ * \brief Starts a second autoref that replaces the running one once it is warmed up
+ *
+ * The new strategy gets the same frames as the running one, but its game
+ * events are only passed on internally and its status is discarded. After
+ * it has handled BACKGROUND_RELOAD_WARMUP_FRAMES frames both are swapped.
+ * History dependent rule state, like timers and remembered collisions, is
+ * rebuilt by the new strategy from the frames seen during the warm-up.
+ */
+void Amun::startBackgroundReload()
+{
+    if (!m_autorefCommand.has_load() || !m_processor) {
+        return;
+    }
+    if (m_standby) {
+        abortBackgroundReload("Background reload restarted");
+    }
+
+    m_standbyThread = new QThread(this);
+    // the warm-up must not compete with the running autoref for its cpus
+    m_threadTopology->manage(m_standbyThread, "autoref reload", AmunOptions::ThreadOptions());
+
+    m_standbyConnection.reset(new StrategyGameControllerMediator(true));
+    m_standbyConnection->switchInternalGameController(true);
+    m_standbyConnection->moveToThread(m_standbyThread);
+
+    m_standby = new Strategy(m_timer, StrategyType::AUTOREF, nullptr, nullptr, m_standbyConnection, false);
+    m_standby->moveToThread(m_standbyThread);
+    connect(m_standbyThread, SIGNAL(finished()), m_standby, SLOT(deleteLater()));
+    connectAutorefInputs(m_standby);
+    connect(m_standby, &Strategy::sendStatus, this, &Amun::handleStandbyStatus);
+    m_standbyThread->start();
+
+    Command load(new amun::Command);
+    *load->mutable_strategy_autoref() = m_autorefCommand;
+    QMetaObject::invokeMethod(m_standby, "handleCommand", Qt::QueuedConnection, Q_ARG(Command, load));
+
+    const StatusBus::Delivery delivery = m_options.latestWinsDelivery ?
+                StatusBus::Delivery::LatestWins : StatusBus::Delivery::Queued;
+    m_strategyStatusBus->subscribe("autoref reload", StatusBus::All, m_standby, &Strategy::handleStatus, delivery);
+
+    m_standbyFrames = 0;
+    m_standbyStartTime = m_timer->currentTime();
+    sendAutorefLog("Background reload started");
+}
+
+/*!
+ * \brief Counts the frames handled by the standby strategy and swaps once it is warmed up
+ */
+void Amun::handleStandbyStatus(const Status &status)
+{
+    static const int BACKGROUND_RELOAD_WARMUP_FRAMES = 60;
+    static const qint64 BACKGROUND_RELOAD_TIMEOUT = 10000000000LL;
+
+    if (!m_standby || sender() != m_standby) {
+        return;
+    }
+    if (status->has_strategy_autoref() && status->strategy_autoref().state() == amun::StatusStrategy::FAILED) {
+        abortBackgroundReload("Background reload failed, keeping the running strategy");
+        return;
+    }
+    for (const amun::DebugValues &debug : status->debug()) {
+        if (debug.source() == amun::Autoref) {
+            m_standbyFrames++;
+            break;
+        }
+    }
+
+    if (m_standbyFrames >= BACKGROUND_RELOAD_WARMUP_FRAMES) {
+        swapAutoref();
+    } else if (m_timer->currentTime() - m_standbyStartTime > BACKGROUND_RELOAD_TIMEOUT) {
+        abortBackgroundReload("Background reload timed out, keeping the running strategy");
+    }
+}
+
+/*!
+ * \brief Replaces the running autoref by the warmed up standby strategy
+ *
+ * The standby strategy already receives every frame, so the running autoref
+ * is only unsubscribed once the outputs of the standby are connected. Thus no
+ * frame is missed, a frame may at most be handled by both strategies.
+ */
+void Amun::swapAutoref()
+{
+    Strategy *standby = m_standby;
+    disconnect(standby, &Strategy::sendStatus, this, &Amun::handleStandbyStatus);
+    connectAutorefOutputs(standby);
+
+    m_strategyStatusBus->unsubscribe(m_autoref);
+    m_strategyStatusBus->rename(standby, "autoref");
+    disconnect(this, SIGNAL(gotCommand(Command)), m_autoref, SLOT(handleCommand(Command)));
+    disconnect(m_autoref, nullptr, this, nullptr);
+    disconnect(m_autoref, nullptr, m_optionsManager, nullptr);
+
+    // the old strategy finishes its current frame, it is deleted on thread shutdown
+    m_threadTopology->release(m_autorefThread);
+    m_autorefThread->quit();
+    m_autorefThread->wait();
+    delete m_autorefThread;
+    m_gameControllerConnection.reset();
+
+    // game events are sent by the new strategy from now on
+    m_gameControllerConnection = m_standbyConnection;
+    connect(m_processor, &Processor::refereeHostChanged, m_gameControllerConnection.get(), &StrategyGameControllerMediator::handleExternalRefereeHost);
+    StrategyGameControllerMediator *connection = m_gameControllerConnection.get();
+    const QString refereeHost = m_refereeHost;
+    QMetaObject::invokeMethod(connection, [connection, refereeHost]() {
+        connection->switchInternalGameController(false);
+        if (!refereeHost.isEmpty()) {
+            connection->handleExternalRefereeHost(refereeHost);
+        }
+    }, Qt::QueuedConnection);
+
+    m_autorefThread = m_standbyThread;
+    m_autoref = standby;
+    m_threadTopology->release(m_autorefThread);
+    m_threadTopology->manage(m_autorefThread, "autoref", m_options.autorefThread);
+
+    const qint64 duration = m_timer->currentTime() - m_standbyStartTime;
+    m_standbyThread = nullptr;
+    m_standby = nullptr;
+    m_standbyConnection.reset();
+    sendAutorefLog(QString("Background reload finished after %1 frames in %2 s")
+                   .arg(m_standbyFrames).arg(duration * 1E-9, 0, 'f', 2));
+}
+
+/*!
+ * \brief Stops the standby strategy, the running autoref is left untouched
+ * \param reason Logged if not empty and a background reload was running
+ */
+void Amun::abortBackgroundReload(const QString &reason)
+{
+    if (!m_standby) {
+        return;
+    }
+    m_strategyStatusBus->unsubscribe(m_standby);
+    disconnect(m_standby, nullptr, this, nullptr);
+    disconnect(m_standby, nullptr, m_optionsManager, nullptr);
+
+    m_threadTopology->release(m_standbyThread);
+    m_standbyThread->quit();
+    m_standbyThread->wait();
+    delete m_standbyThread;
+
+    m_standbyThread = nullptr;
+    m_standby = nullptr;
+    m_standbyConnection.reset();
+    if (!reason.isEmpty()) {
+        sendAutorefLog(reason);
+    }
+}
+
+/*!
+ * \brief Watches the lua files next to the loaded strategy for automatic background reloads
+ */
+void Amun::updateReloadWatcher()
+{
+    delete m_reloadWatcher;
+    m_reloadWatcher = nullptr;
+    if (!m_autoReload || !m_autorefCommand.has_load()) {
+        return;
+    }
+
+    const QString directory = QFileInfo(QString::fromStdString(m_autorefCommand.load().filename())).absolutePath();
+    QStringList files { directory };
+    QDirIterator it(directory, { "*.lua" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.append(it.next());
+    }
+
+    m_reloadWatcher = new QFileSystemWatcher(files, this);
+    auto fileChanged = [this](const QString &path) {
+        // editors that replace the file on saving remove it from the watch list
+        if (QFileInfo::exists(path) && !m_reloadWatcher->files().contains(path)) {
+            m_reloadWatcher->addPath(path);
+        }
+        m_reloadDelay->start();
+    };
+    connect(m_reloadWatcher, &QFileSystemWatcher::fileChanged, this, fileChanged);
+    connect(m_reloadWatcher, &QFileSystemWatcher::directoryChanged, this, fileChanged);
+}
+
+/*!
+ * \brief Publishes a log message in the name of the autoref
+ */
+void Amun::sendAutorefLog(const QString &text)
+{
+    Status status(new amun::Status);
+    amun::DebugValues *debug = status->add_debug();
+    debug->set_source(amun::Autoref);
+    debug->add_log()->set_text(text.toStdString());
+    handleStatus(status);
+}
+
 /*!
  * \brief Add timestamp and emit \ref sendStatus
  * \param status Status to send
@@ -227,5 +656,103 @@ void Amun::handleCommand(const Command &command)
 void Amun::handleStatus(const Status &status)
 {
     status->set_time(m_timer->currentTime());
+    updateStatistics(status);
     emit sendStatus(status);
+    m_statusBus->publish(status);
+}
+
+//! Remembers the receive time of a vision packet, called from the network thread
+void Amun::addVisionPacketTime(qint64 time)
+{
+    m_visionPacketTimes[m_visionPacketIndex % m_visionPacketTimes.size()].store(time, std::memory_order_relaxed);
+    m_visionPacketIndex++;
+}
+
+/*!
+ * \brief Returns the receive time of the newest vision packet before the tracking time
+ *
+ * This is the newest packet that can have been used for a world state with
+ * the given time. Packets that arrived while the tracking was running are
+ * skipped. Returns 0 if no such packet is remembered.
+ */
+qint64 Amun::newestVisionPacketTime(qint64 trackingTime) const
+{
+    qint64 newest = 0;
+    for (const std::atomic<qint64> &packetTime : m_visionPacketTimes) {
+        const qint64 time = packetTime.load(std::memory_order_relaxed);
+        if (time <= trackingTime) {
+            newest = std::max(newest, time);
+        }
+    }
+    return newest;
+}
+
+/*!
+ * \brief Collects the latency of each processing stage
+ *
+ * Every latency is measured relative to the tracking time of the world state
+ * in which the vision data was used. The vision latency assumes that the
+ * processor has handled every packet received before the tracking time, it
+ * is too low if packets are still queued for the processor. The stages of the autoref strategy are
+ * measured in Lua and reported as debug values below "Latency".
+ * A summary is published once per second together with the scheduler
+ * statistics of the threads and the delivery statistics of the status bus.
+ */
+void Amun::updateStatistics(const Status &status)
+{
+    static const qint64 REPORT_INTERVAL = 1000000000LL;
+    static const std::string STRATEGY_LATENCY_PREFIX = "Latency/";
+
+    if (status->has_world_state()) {
+        m_framesSinceReport++;
+        const qint64 trackingTime = status->world_state().time();
+        const qint64 visionTime = newestVisionPacketTime(trackingTime);
+        if (visionTime > 0) {
+            m_latency->addSample("vision receive to tracking", trackingTime - visionTime);
+        }
+    }
+
+    for (const amun::DebugValues &debug : status->debug()) {
+        if (debug.source() != amun::Autoref) {
+            continue;
+        }
+        for (const amun::DebugValue &value : debug.value()) {
+            const std::string &key = value.key();
+            if (value.has_float_value() && key.compare(0, STRATEGY_LATENCY_PREFIX.size(), STRATEGY_LATENCY_PREFIX) == 0) {
+                m_latency->addSample(key.substr(STRATEGY_LATENCY_PREFIX.size()), value.float_value() * 1E9);
+            }
+        }
+    }
+
+    const qint64 now = status->time();
+    if (m_lastLatencyReport == 0) {
+        m_lastLatencyReport = now;
+    } else if (now - m_lastLatencyReport >= REPORT_INTERVAL) {
+        Status report(new amun::Status);
+        report->set_time(now);
+        amun::DebugValues *debug = report->add_debug();
+        debug->set_source(amun::Controller);
+        if (AllocationCounter::isEnabled()) {
+            const quint64 allocations = AllocationCounter::count();
+            auto addValue = [debug](const char *key, float value) {
+                amun::DebugValue *debugValue = debug->add_value();
+                debugValue->set_key(key);
+                debugValue->set_float_value(value);
+            };
+            addValue("Allocations/per second", (allocations - m_allocationsAtReport) * 1E9f / (now - m_lastLatencyReport));
+            if (m_framesSinceReport > 0) {
+                addValue("Allocations/per frame", float(allocations - m_allocationsAtReport) / m_framesSinceReport);
+            }
+            m_allocationsAtReport = allocations;
+        }
+        m_framesSinceReport = 0;
+        m_lastLatencyReport = now;
+        m_latency->addToDebugValues(debug);
+        m_threadTopology->addToDebugValues(debug, now);
+        m_statusBus->addToDebugValues(debug);
+        m_strategyStatusBus->addToDebugValues(debug);
+        if (debug->value_size() > 0) {
+            emit sendStatus(report);
+        }
+    }
 }
@@ -0,0 +1,165 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "amunoptions.h"
+#include <QFileInfo>
+#include <QSettings>
+#include <QStringList>
+
+static AmunOptions defaultOptions;
+
+/*!
+ * \brief Set the options used by all Amun instances created afterwards
+ */
+void AmunOptions::setDefault(const AmunOptions &options)
+{
+    defaultOptions = options;
+}
+
+AmunOptions AmunOptions::getDefault()
+{
+    return defaultOptions;
+}
+
+/*!
+ * \brief Returns the options of the thread with the given name
+ * \param name one of processor, network, network-engine and autoref
+ * \return the thread options or nullptr for an unknown name
+ */
+AmunOptions::ThreadOptions *AmunOptions::threadOptions(const QString &name)
+{
+    if (name == "processor") {
+        return &processorThread;
+    } else if (name == "network") {
+        return &networkThread;
+    } else if (name == "network-engine") {
+        return &networkEngineThread;
+    } else if (name == "autoref") {
+        return &autorefThread;
+    }
+    return nullptr;
+}
+
+/*!
+ * \brief Parses a cpu list like "1,3-5"
+ */
+bool AmunOptions::parseCpuList(const QString &list, std::vector<int> &cpus)
+{
+    cpus.clear();
+    for (const QString &part : list.split(',', Qt::SkipEmptyParts)) {
+        const QStringList range = part.trimmed().split('-');
+        bool okFirst = false, okLast = false;
+        const int first = range.first().toInt(&okFirst);
+        const int last = range.last().toInt(&okLast);
+        if (range.size() > 2 || !okFirst || !okLast || first < 0 || last < first) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Parses a thread specification like "cpus=2-3:fifo=50:nice=-5"
+ */
+bool AmunOptions::parseThreadOptions(const QString &spec, ThreadOptions &options)
+{
+    for (const QString &setting : spec.split(':', Qt::SkipEmptyParts)) {
+        const int split = setting.indexOf('=');
+        if (split < 0) {
+            return false;
+        }
+        const QString key = setting.left(split).trimmed();
+        const QString value = setting.mid(split + 1).trimmed();
+        bool ok = false;
+        if (key == "cpus") {
+            ok = parseCpuList(value, options.cpus);
+        } else if (key == "fifo") {
+            options.realtimePriority = value.toInt(&ok);
+            ok = ok && options.realtimePriority >= 0 && options.realtimePriority <= 99;
+        } else if (key == "nice") {
+            options.nice = value.toInt(&ok);
+            ok = ok && *options.nice >= -20 && *options.nice <= 19;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Loads the thread topology from an ini file
+ *
+ * The general group may contain the isolated_cpus. Each thread has its own
+ * group with the optional keys cpus, fifo and nice, e.g.
+ * \code
+ * [general]
+ * isolated_cpus=2-3
+ * [autoref]
+ * cpus=3
+ * fifo=50
+ * \endcode
+ */
+bool AmunOptions::loadThreadConfig(const QString &filename, QString &error)
+{
+    if (!QFileInfo::exists(filename)) {
+        error = "File does not exist";
+        return false;
+    }
+    QSettings settings(filename, QSettings::IniFormat);
+    if (settings.status() != QSettings::NoError) {
+        error = "Could not parse file";
+        return false;
+    }
+
+    // QSettings splits comma separated values into lists
+    auto stringValue = [&settings](const QString &key) {
+        return settings.value(key).toStringList().join(',');
+    };
+
+    if (settings.contains("general/isolated_cpus") && !parseCpuList(stringValue("general/isolated_cpus"), isolatedCpus)) {
+        error = "Invalid isolated_cpus";
+        return false;
+    }
+
+    for (const QString &group : settings.childGroups()) {
+        if (group == "general") {
+            continue;
+        }
+        ThreadOptions *options = threadOptions(group);
+        if (!options) {
+            error = "Unknown thread " + group;
+            return false;
+        }
+        QStringList spec;
+        for (const QString &key : {"cpus", "fifo", "nice"}) {
+            if (settings.contains(group + "/" + key)) {
+                spec.append(key + "=" + stringValue(group + "/" + key));
+            }
+        }
+        if (!parseThreadOptions(spec.join(':'), *options)) {
+            error = "Invalid settings for thread " + group;
+            return false;
+        }
+    }
+    return true;
+}
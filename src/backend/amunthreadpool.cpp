@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "amunthreadpool.h"
+#include "threadtopology.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+
+AmunThreadPool::AmunThreadPool(int workerCount, const AmunOptions &options) :
+    m_topology(new ThreadTopology(options.isolatedCpus))
+{
+    workerCount = std::max(workerCount, 1);
+    // a single worker runs everything, the tracking has priority then
+    const int processorWorkers = workerCount == 1 ? 1 : workerCount / 2;
+    for (int i = 0; i < processorWorkers; i++) {
+        QThread *worker = new QThread;
+        m_topology->manage(worker, QString("processor worker %1").arg(i + 1), options.processorThread);
+        m_processorWorkers.push_back(worker);
+    }
+    for (int i = 0; i < workerCount - processorWorkers; i++) {
+        QThread *worker = new QThread;
+        m_topology->manage(worker, QString("strategy worker %1").arg(i + 1), options.autorefThread);
+        m_strategyWorkers.push_back(worker);
+    }
+
+    m_networkThread = new QThread;
+    m_topology->manage(m_networkThread, "network", options.networkThread);
+#ifdef Q_OS_LINUX
+    if (options.networkBackend == AmunOptions::NetworkBackend::Batched) {
+        m_networkEngineThread = new QThread;
+        m_topology->manage(m_networkEngineThread, "network-engine", options.networkEngineThread);
+    }
+#endif
+
+    for (QThread *worker : m_processorWorkers) {
+        worker->start();
+    }
+    for (QThread *worker : m_strategyWorkers) {
+        worker->start();
+    }
+    m_networkThread->start();
+    if (m_networkEngineThread) {
+        m_networkEngineThread->start();
+    }
+}
+
+AmunThreadPool::~AmunThreadPool()
+{
+    std::vector<QThread *> threads = m_processorWorkers;
+    threads.insert(threads.end(), m_strategyWorkers.begin(), m_strategyWorkers.end());
+    threads.push_back(m_networkThread);
+    if (m_networkEngineThread) {
+        threads.push_back(m_networkEngineThread);
+    }
+    for (QThread *thread : threads) {
+        thread->quit();
+    }
+    for (QThread *thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+QThread *AmunThreadPool::strategyWorker(int instance) const
+{
+    if (m_strategyWorkers.empty()) {
+        return processorWorker(instance);
+    }
+    return m_strategyWorkers[instance % m_strategyWorkers.size()];
+}
+
+void AmunThreadPool::addToDebugValues(amun::DebugValues *debug, qint64 now)
+{
+    QMutexLocker locker(&m_topologyMutex);
+    m_topology->addToDebugValues(debug, now);
+}
@@ -0,0 +1,188 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "batchedreceiver.h"
+#include "core/timer.h"
+#include <QDebug>
+#include <QNetworkInterface>
+#include <QSocketNotifier>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+BatchedReceiver::BatchedReceiver(const QHostAddress &groupAddress, quint16 port, Timer *timer, QObject *parent) :
+    QObject(parent),
+    m_groupAddress(groupAddress),
+    m_port(port),
+    m_timer(timer)
+{
+    m_buffer.resize(BATCH_SIZE * MAX_DATAGRAM_SIZE);
+}
+
+BatchedReceiver::~BatchedReceiver()
+{
+    closeSocket();
+}
+
+void BatchedReceiver::closeSocket()
+{
+    delete m_notifier;
+    m_notifier = nullptr;
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void BatchedReceiver::startListen()
+{
+    closeSocket();
+
+    m_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_fd < 0) {
+        qWarning() << "Could not create socket: " << std::strerror(errno);
+        return;
+    }
+
+    const int enable = 1;
+    ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    // let the kernel stamp every datagram on arrival
+    ::setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+    // only receive the groups joined by this socket, the socket is bound to
+    // every address and other sockets may join other groups on the same port
+    const int disable = 0;
+    ::setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_ALL, &disable, sizeof(disable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (::bind(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+        qWarning() << "Could not bind to port" << m_port << ":" << std::strerror(errno);
+        closeSocket();
+
+        Status status(new amun::Status);
+        status->mutable_amun_state()->set_port_bind_error(true);
+        emit sendStatus(status);
+        return;
+    }
+
+    for (const QNetworkInterface &interface : QNetworkInterface::allInterfaces()) {
+        if (interface.flags() & QNetworkInterface::CanMulticast) {
+            joinGroup(interface.index());
+        }
+    }
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &BatchedReceiver::readData);
+}
+
+void BatchedReceiver::updatePort(quint16 port)
+{
+    if (port == m_port && m_fd >= 0) {
+        return;
+    }
+    m_port = port;
+    startListen();
+}
+
+void BatchedReceiver::updateInterface(const QNetworkInterface &interface)
+{
+    if (m_fd >= 0) {
+        joinGroup(interface.index());
+    }
+}
+
+void BatchedReceiver::joinGroup(int interfaceIndex)
+{
+    ip_mreqn request = {};
+    request.imr_multiaddr.s_addr = htonl(m_groupAddress.toIPv4Address());
+    request.imr_ifindex = interfaceIndex;
+    if (::setsockopt(m_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request)) < 0 && errno != EADDRINUSE) {
+        qDebug() << "Could not join multicast group on interface" << interfaceIndex << ":" << std::strerror(errno);
+    }
+}
+
+qint64 BatchedReceiver::receiveTime(const msghdr &header, qint64 currentTime, qint64 currentSystemTime) const
+{
+    for (const cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr;
+            cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&header), const_cast<cmsghdr*>(cmsg))) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec stamp;
+            std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+            const qint64 kernelTime = stamp.tv_sec * 1000000000LL + stamp.tv_nsec;
+            // the kernel stamps with the system clock, translate the age of the
+            // packet to the time base of the (possibly scaled) amun timer
+            const qint64 age = currentSystemTime - kernelTime;
+            return currentTime - std::max<qint64>(age, 0);
+        }
+    }
+    return currentTime;
+}
+
+void BatchedReceiver::readData()
+{
+    // the socket notifier fires again for the datagrams that are left
+    for (int batch = 0; batch < MAX_BATCHES_PER_READ; batch++) {
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            m_iovecs[i].iov_base = m_buffer.data() + i * MAX_DATAGRAM_SIZE;
+            m_iovecs[i].iov_len = MAX_DATAGRAM_SIZE;
+
+            msghdr &header = m_messages[i].msg_hdr;
+            header.msg_name = &m_senders[i];
+            header.msg_namelen = sizeof(m_senders[i]);
+            header.msg_iov = &m_iovecs[i];
+            header.msg_iovlen = 1;
+            header.msg_control = m_control[i].data;
+            header.msg_controllen = sizeof(m_control[i].data);
+            header.msg_flags = 0;
+        }
+
+        const int count = ::recvmmsg(m_fd, m_messages.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (count < 0 && errno == EINTR) {
+            batch--;
+            continue;
+        } else if (count <= 0) {
+            // the socket is drained
+            return;
+        }
+
+        const qint64 currentTime = m_timer->currentTime();
+        timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        const qint64 currentSystemTime = now.tv_sec * 1000000000LL + now.tv_nsec;
+
+        for (int i = 0; i < count; i++) {
+            const msghdr &header = m_messages[i].msg_hdr;
+            if (header.msg_flags & MSG_TRUNC) {
+                continue;
+            }
+            const QByteArray data(static_cast<const char*>(m_iovecs[i].iov_base), m_messages[i].msg_len);
+            const QString sender = QHostAddress(ntohl(m_senders[i].sin_addr.s_addr)).toString();
+            emit gotPacket(data, receiveTime(header, currentTime, currentSystemTime), sender);
+        }
+
+        if (count < BATCH_SIZE) {
+            return;
+        }
+    }
+}
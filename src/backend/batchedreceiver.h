@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef BATCHEDRECEIVER_H
+#define BATCHEDRECEIVER_H
+
+#include "protobuf/status.h"
+#include <QByteArray>
+#include <QHostAddress>
+#include <QObject>
+#include <QString>
+#include <array>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+class QNetworkInterface;
+class QSocketNotifier;
+class Timer;
+
+/*!
+ * \brief Multicast receiver which reads all pending datagrams at once
+ *
+ * Drop-in replacement for Receiver on Linux. Every wakeup drains the socket
+ * using recvmmsg and the packets are stamped with the kernel receive time
+ * instead of the time the event loop got around to reading them.
+ */
+class BatchedReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    BatchedReceiver(const QHostAddress &groupAddress, quint16 port, Timer *timer, QObject *parent = nullptr);
+    ~BatchedReceiver() override;
+    BatchedReceiver(const BatchedReceiver&) = delete;
+    BatchedReceiver& operator=(const BatchedReceiver&) = delete;
+
+signals:
+    void gotPacket(const QByteArray &data, qint64 time, QString sender);
+    void sendStatus(const Status &status);
+
+public slots:
+    void startListen();
+    void updatePort(quint16 port);
+    void updateInterface(const QNetworkInterface &interface);
+
+private slots:
+    void readData();
+
+private:
+    void closeSocket();
+    void joinGroup(int interfaceIndex);
+    qint64 receiveTime(const msghdr &header, qint64 currentTime, qint64 currentSystemTime) const;
+
+private:
+    static constexpr int BATCH_SIZE = 16;
+    static constexpr int MAX_DATAGRAM_SIZE = 65536;
+    //! the remaining datagrams are read after the other receivers got their turn
+    static constexpr int MAX_BATCHES_PER_READ = 2;
+
+    struct ControlBuffer {
+        alignas(cmsghdr) char data[CMSG_SPACE(sizeof(timespec))];
+    };
+
+    const QHostAddress m_groupAddress;
+    quint16 m_port;
+    Timer *m_timer;
+
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+
+    QByteArray m_buffer;
+    std::array<mmsghdr, BATCH_SIZE> m_messages;
+    std::array<iovec, BATCH_SIZE> m_iovecs;
+    std::array<sockaddr_in, BATCH_SIZE> m_senders;
+    std::array<ControlBuffer, BATCH_SIZE> m_control;
+};
+
+#endif // BATCHEDRECEIVER_H
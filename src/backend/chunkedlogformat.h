@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef CHUNKEDLOGFORMAT_H
+#define CHUNKEDLOGFORMAT_H
+
+#include <QByteArray>
+#include <QtEndian>
+#include <QtGlobal>
+
+/*
+ * Layout of a chunked log, all integers are little endian:
+ *
+ * file header:  8 byte magic FILE_MAGIC
+ * chunk:        u32 CHUNK_MARKER, u32 compressed size, u32 status count,
+ *               i64 first status time, i64 last status time,
+ *               qCompress'ed sequence of (u32 size, serialized status)
+ * index:        u32 chunk count, per chunk u64 offset of the chunk header,
+ *               u32 compressed size, u32 status count, i64 first time, i64 last time
+ * trailer:      u64 offset of the index, 8 byte magic INDEX_MAGIC
+ *
+ * Every chunk can be decompressed on its own. The index is only written when
+ * the log is closed; a reader rebuilds it from the chunk headers if it is missing.
+ */
+namespace ChunkedLogFormat {
+    const char FILE_MAGIC[] = "ARCHUNK1";
+    const char INDEX_MAGIC[] = "ARINDEX1";
+    const int MAGIC_SIZE = 8;
+    const quint32 CHUNK_MARKER = 0x4b4e4843; // "CHNK"
+    const int CHUNK_HEADER_SIZE = 4 + 4 + 4 + 8 + 8;
+    const int INDEX_ENTRY_SIZE = 8 + 4 + 4 + 8 + 8;
+    const int TRAILER_SIZE = 8 + MAGIC_SIZE;
+
+    template<typename T>
+    void append(QByteArray &data, T value)
+    {
+        const T little = qToLittleEndian(value);
+        data.append(reinterpret_cast<const char *>(&little), sizeof(T));
+    }
+
+    template<typename T>
+    T read(const uchar *data)
+    {
+        return qFromLittleEndian<T>(data);
+    }
+}
+
+#endif // CHUNKEDLOGFORMAT_H
@@ -0,0 +1,259 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "chunkedlogreader.h"
+#include "chunkedlogformat.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace ChunkedLogFormat;
+
+ChunkedLogReader::ChunkedLogReader() = default;
+
+ChunkedLogReader::~ChunkedLogReader()
+{
+    close();
+}
+
+bool ChunkedLogReader::isChunkedLog(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(MAGIC_SIZE) == QByteArray(FILE_MAGIC, MAGIC_SIZE);
+}
+
+bool ChunkedLogReader::open(const QString &filename)
+{
+    close();
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorMsg = "Could not open log file " + filename + ": " + m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        m_errorMsg = "Could not map log file " + filename + ": " + m_file.errorString();
+        close();
+        return false;
+    }
+    if (m_size < MAGIC_SIZE || std::memcmp(m_data, FILE_MAGIC, MAGIC_SIZE) != 0) {
+        m_errorMsg = filename + " is not a chunked log";
+        close();
+        return false;
+    }
+
+    // a log which was not closed properly has no index
+    if (!readIndex() && !scanChunks()) {
+        m_errorMsg = filename + " is corrupted";
+        close();
+        return false;
+    }
+    m_statusCount = 0;
+    for (const Chunk &chunk : m_chunks) {
+        m_statusCount += chunk.statusCount;
+    }
+    return seek(startTime());
+}
+
+void ChunkedLogReader::close()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_size = 0;
+    m_chunks.clear();
+    m_statusCount = 0;
+    m_currentChunk = -1;
+    m_chunkData.clear();
+    m_chunkPos = 0;
+}
+
+qint64 ChunkedLogReader::startTime() const
+{
+    return m_chunks.empty() ? 0 : m_chunks.front().firstTime;
+}
+
+qint64 ChunkedLogReader::endTime() const
+{
+    return m_chunks.empty() ? 0 : m_chunks.back().lastTime;
+}
+
+bool ChunkedLogReader::readIndex()
+{
+    if (m_size < MAGIC_SIZE + TRAILER_SIZE) {
+        return false;
+    }
+    const uchar *trailer = m_data + m_size - TRAILER_SIZE;
+    if (std::memcmp(trailer + 8, INDEX_MAGIC, MAGIC_SIZE) != 0) {
+        return false;
+    }
+    const quint64 indexOffset = read<quint64>(trailer);
+    if (indexOffset < quint64(MAGIC_SIZE) || indexOffset + 4 > quint64(m_size - TRAILER_SIZE)) {
+        return false;
+    }
+    const quint32 count = read<quint32>(m_data + indexOffset);
+    if (indexOffset + 4 + quint64(count) * INDEX_ENTRY_SIZE != quint64(m_size - TRAILER_SIZE)) {
+        return false;
+    }
+
+    m_chunks.clear();
+    m_chunks.reserve(count);
+    const uchar *entry = m_data + indexOffset + 4;
+    for (quint32 i = 0; i < count; i++, entry += INDEX_ENTRY_SIZE) {
+        const Chunk chunk {
+            read<quint64>(entry), read<quint32>(entry + 8), read<quint32>(entry + 12),
+            read<qint64>(entry + 16), read<qint64>(entry + 24)
+        };
+        if (chunk.offset < quint64(MAGIC_SIZE) || chunk.offset + CHUNK_HEADER_SIZE + chunk.compressedSize > indexOffset) {
+            return false;
+        }
+        // the entry must point to the header of the same chunk, otherwise the chunks are scanned
+        const uchar *header = m_data + chunk.offset;
+        if (read<quint32>(header) != CHUNK_MARKER || read<quint32>(header + 4) != chunk.compressedSize) {
+            return false;
+        }
+        m_chunks.push_back(chunk);
+    }
+    return true;
+}
+
+bool ChunkedLogReader::scanChunks()
+{
+    m_chunks.clear();
+    quint64 offset = MAGIC_SIZE;
+    while (offset + CHUNK_HEADER_SIZE <= quint64(m_size)) {
+        const uchar *header = m_data + offset;
+        if (read<quint32>(header) != CHUNK_MARKER) {
+            break;
+        }
+        const Chunk chunk {
+            offset, read<quint32>(header + 4), read<quint32>(header + 8),
+            read<qint64>(header + 12), read<qint64>(header + 20)
+        };
+        if (offset + CHUNK_HEADER_SIZE + chunk.compressedSize > quint64(m_size)) {
+            // the last chunk was only partially written
+            break;
+        }
+        m_chunks.push_back(chunk);
+        offset += CHUNK_HEADER_SIZE + chunk.compressedSize;
+    }
+    return offset > quint64(MAGIC_SIZE) || offset == quint64(m_size);
+}
+
+bool ChunkedLogReader::loadChunk(int chunk)
+{
+    m_currentChunk = chunk;
+    m_chunkPos = 0;
+    m_chunkData.clear();
+    if (chunk >= int(m_chunks.size())) {
+        return true;
+    }
+    const Chunk &info = m_chunks[chunk];
+    // avoid copying the compressed data out of the mapping
+    const QByteArray compressed = QByteArray::fromRawData(
+                reinterpret_cast<const char *>(m_data + info.offset + CHUNK_HEADER_SIZE), info.compressedSize);
+    m_chunkData = qUncompress(compressed);
+    if (m_chunkData.isEmpty()) {
+        m_errorMsg = QString("Could not decompress chunk %1").arg(chunk);
+        return false;
+    }
+    return true;
+}
+
+bool ChunkedLogReader::seek(qint64 time)
+{
+    if (!m_data) {
+        return false;
+    }
+    // last chunk starting before or at the time, the status may also be at the start of the next one
+    auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), time, [](qint64 time, const Chunk &chunk) {
+        return time < chunk.firstTime;
+    });
+    const int chunk = std::max<int>(int(it - m_chunks.begin()) - 1, 0);
+    if (!loadChunk(chunk)) {
+        return false;
+    }
+
+    while (!atEnd()) {
+        if (m_chunkPos >= m_chunkData.size() && !loadChunk(m_currentChunk + 1)) {
+            return false;
+        }
+        const int position = m_chunkPos;
+        const Status status = parseNextStatus();
+        if (!status) {
+            return false;
+        }
+        if (status->time() >= time) {
+            m_chunkPos = position;
+            return true;
+        }
+    }
+    return true;
+}
+
+bool ChunkedLogReader::atEnd() const
+{
+    if (m_currentChunk < 0 || m_currentChunk >= int(m_chunks.size())) {
+        return true;
+    }
+    return m_chunkPos >= m_chunkData.size() && m_currentChunk + 1 >= int(m_chunks.size());
+}
+
+Status ChunkedLogReader::readStatus()
+{
+    if (atEnd()) {
+        return Status();
+    }
+    return parseNextStatus();
+}
+
+Status ChunkedLogReader::parseNextStatus()
+{
+    if (m_chunkPos >= m_chunkData.size()) {
+        if (!loadChunk(m_currentChunk + 1) || m_chunkData.isEmpty()) {
+            return Status();
+        }
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(m_chunkData.constData());
+    if (m_chunkPos + 4 > m_chunkData.size()) {
+        m_errorMsg = QString("Truncated status in chunk %1").arg(m_currentChunk);
+        return Status();
+    }
+    const quint32 size = read<quint32>(data + m_chunkPos);
+    m_chunkPos += 4;
+    if (size > quint32(m_chunkData.size() - m_chunkPos)) {
+        m_errorMsg = QString("Truncated status in chunk %1").arg(m_currentChunk);
+        return Status();
+    }
+
+    Status status(new amun::Status);
+    if (!status->ParseFromArray(data + m_chunkPos, size)) {
+        m_errorMsg = QString("Invalid status in chunk %1").arg(m_currentChunk);
+        return Status();
+    }
+    m_chunkPos += size;
+    return status;
+}
@@ -0,0 +1,178 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "chunkedlogwriter.h"
+#include "chunkedlogformat.h"
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+using namespace ChunkedLogFormat;
+
+ChunkedLogWriter::ChunkedLogWriter(QObject *parent) :
+    ChunkedLogWriter(Options(), parent)
+{
+}
+
+ChunkedLogWriter::ChunkedLogWriter(const Options &options, QObject *parent) :
+    QObject(parent),
+    m_options(options)
+{
+}
+
+ChunkedLogWriter::~ChunkedLogWriter()
+{
+    close();
+}
+
+bool ChunkedLogWriter::open(const QString &filename)
+{
+    close();
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_errorMsg = "Could not open log file " + filename + ": " + m_file.errorString();
+        return false;
+    }
+    if (m_file.write(FILE_MAGIC, MAGIC_SIZE) != MAGIC_SIZE) {
+        m_errorMsg = "Could not write log file " + filename + ": " + m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    m_index.clear();
+    m_chunkCount = 0;
+    return true;
+}
+
+/*!
+ * \brief Writes the pending statuses and the index and closes the file
+ *
+ * \return false if anything could not be written, see errorMsg()
+ */
+bool ChunkedLogWriter::close()
+{
+    if (!m_file.isOpen()) {
+        return true;
+    }
+    bool success = writeChunk();
+
+    QByteArray index;
+    append<quint32>(index, m_chunkCount);
+    index.append(m_index);
+    append<quint64>(index, m_file.pos());
+    index.append(INDEX_MAGIC, MAGIC_SIZE);
+    if (m_file.write(index) != index.size()) {
+        m_errorMsg = "Could not write log file " + m_file.fileName() + ": " + m_file.errorString();
+        success = false;
+    }
+    m_file.close();
+    return success;
+}
+
+/*!
+ * \brief Writes the pending statuses as a chunk and forces the file to disk
+ *
+ * Thus at most the statuses since the last flush are lost if the process is
+ * killed. The index is still only written by close.
+ */
+bool ChunkedLogWriter::flush()
+{
+    if (!m_file.isOpen()) {
+        return true;
+    }
+    if (!writeChunk()) {
+        return false;
+    }
+    if (!m_file.flush()) {
+        m_errorMsg = "Could not write log file " + m_file.fileName() + ": " + m_file.errorString();
+        return false;
+    }
+#ifdef Q_OS_UNIX
+    ::fsync(m_file.handle());
+#endif
+    return true;
+}
+
+/*!
+ * \brief Appends a status to the current chunk
+ *
+ * \return false if the log is not open or a completed chunk could not be
+ * written, see errorMsg()
+ */
+bool ChunkedLogWriter::writeStatus(const Status &status)
+{
+    if (!m_file.isOpen()) {
+        m_errorMsg = "Log file is not open";
+        return false;
+    }
+
+    const int size = status->ByteSizeLong();
+    m_serialized.resize(size);
+    status->SerializeToArray(m_serialized.data(), size);
+    append<quint32>(m_chunk, size);
+    m_chunk.append(m_serialized);
+
+    if (m_chunkStatusCount == 0) {
+        m_chunkFirstTime = status->time();
+    }
+    m_chunkLastTime = status->time();
+    m_chunkStatusCount++;
+
+    if (m_chunk.size() >= m_options.chunkBytes
+            || m_chunkLastTime - m_chunkFirstTime >= m_options.chunkDuration) {
+        return writeChunk();
+    }
+    return true;
+}
+
+bool ChunkedLogWriter::writeChunk()
+{
+    if (m_chunkStatusCount == 0) {
+        return true;
+    }
+
+    const QByteArray compressed = qCompress(m_chunk, m_options.compressionLevel);
+    QByteArray header;
+    append<quint32>(header, CHUNK_MARKER);
+    append<quint32>(header, compressed.size());
+    append<quint32>(header, m_chunkStatusCount);
+    append<qint64>(header, m_chunkFirstTime);
+    append<qint64>(header, m_chunkLastTime);
+
+    const qint64 offset = m_file.pos();
+    const quint32 statusCount = m_chunkStatusCount;
+    // keeps the capacity for the next chunk
+    m_chunk.truncate(0);
+    m_chunkStatusCount = 0;
+
+    if (m_file.write(header) != header.size() || m_file.write(compressed) != compressed.size()) {
+        m_errorMsg = "Could not write log file " + m_file.fileName() + ": " + m_file.errorString();
+        return false;
+    }
+
+    // only chunks which are completely in the file are indexed
+    append<quint64>(m_index, offset);
+    append<quint32>(m_index, compressed.size());
+    append<quint32>(m_index, statusCount);
+    append<qint64>(m_index, m_chunkFirstTime);
+    append<qint64>(m_index, m_chunkLastTime);
+    m_chunkCount++;
+    return true;
+}
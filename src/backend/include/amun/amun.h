@@ -24,13 +24,22 @@
 #include "protobuf/command.h"
 #include "protobuf/status.h"
 #include "gamecontroller/strategygamecontrollermediator.h"
+#include "amunoptions.h"
+#include <array>
+#include <atomic>
 #include <memory>
 #include <QObject>
 
+class BatchedReceiver;
+class QFileSystemWatcher;
+class QTimer;
+class LatencyStatistics;
 class NetworkInterfaceWatcher;
 class Processor;
 class Receiver;
+class StatusBus;
 class Strategy;
+class ThreadTopology;
 class Timer;
 class QHostAddress;
 class OptionsManager;
@@ -42,6 +51,7 @@ class Amun : public QObject
 
 public:
     explicit Amun(bool simulatorOnly, QObject *parent = 0);
+    Amun(bool simulatorOnly, const AmunOptions &options, QObject *parent = 0);
     ~Amun() override;
 
 signals:
@@ -61,19 +71,40 @@ public slots:
 
 private slots:
     void handleStatus(const Status &status);
+    void handleStandbyStatus(const Status &status);
+    void startBackgroundReload();
 
 signals:
     void gotReplayStatus(const Status &status);
 
 private:
     void setupReceiver(Receiver *&receiver, const QHostAddress &address, quint16 port);
+    void setupBatchedReceiver(BatchedReceiver *&receiver, const QHostAddress &address, quint16 port);
+    void setupNetwork();
+    void stopThreads();
+    void connectAutorefInputs(Strategy *strategy);
+    void connectAutorefOutputs(Strategy *strategy);
+    bool handleBackgroundReload(const Command &command);
+    void abortBackgroundReload(const QString &reason);
+    void swapAutoref();
+    void updateReloadWatcher();
+    void sendAutorefLog(const QString &text);
+    void updateStatistics(const Status &status);
+    void addVisionPacketTime(qint64 time);
+    qint64 newestVisionPacketTime(qint64 trackingTime) const;
+
+    const AmunOptions m_options;
+
     QThread *m_processorThread = nullptr;
     QThread *m_networkThread = nullptr;
+    QThread *m_networkEngineThread = nullptr;
     QThread *m_autorefThread = nullptr;
 
     Processor *m_processor = nullptr;
     Receiver *m_referee = nullptr;
     Receiver *m_vision = nullptr;
+    BatchedReceiver *m_batchedReferee = nullptr;
+    BatchedReceiver *m_batchedVision = nullptr;
     Strategy *m_autoref = nullptr;
     OptionsManager *m_optionsManager = nullptr;
     qint64 m_lastTime;
@@ -82,8 +113,35 @@ private:
     NetworkInterfaceWatcher *m_networkInterfaceWatcher = nullptr;
 
     VisionTrackedPublisher *m_visionPublisher = nullptr;
+    //! distributes the statuses to the backend internal consumers
+    StatusBus *m_statusBus = nullptr;
+    //! distributes the statuses of the processor to the strategy
+    StatusBus *m_strategyStatusBus = nullptr;
 
     std::shared_ptr<StrategyGameControllerMediator> m_gameControllerConnection;
+    QString m_refereeHost;
+
+    //! load command of the autoref, replayed to the standby strategy on a background reload
+    amun::CommandStrategy m_autorefCommand;
+    bool m_autoReload = false;
+    //! strategy that is warmed up on the live frames before replacing the autoref
+    QThread *m_standbyThread = nullptr;
+    Strategy *m_standby = nullptr;
+    std::shared_ptr<StrategyGameControllerMediator> m_standbyConnection;
+    int m_standbyFrames = 0;
+    qint64 m_standbyStartTime = 0;
+    QFileSystemWatcher *m_reloadWatcher = nullptr;
+    QTimer *m_reloadDelay = nullptr;
+
+    //! receive times of the latest vision packets, written by the network thread
+    std::array<std::atomic<qint64>, 32> m_visionPacketTimes {};
+    //! only used by the network thread
+    quint32 m_visionPacketIndex = 0;
+    std::unique_ptr<LatencyStatistics> m_latency;
+    qint64 m_lastLatencyReport = 0;
+    std::unique_ptr<ThreadTopology> m_threadTopology;
+    qint64 m_framesSinceReport = 0;
+    quint64 m_allocationsAtReport = 0;
 };
 
 #endif // AMUN_H
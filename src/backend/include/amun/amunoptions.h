@@ -0,0 +1,83 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef AMUNOPTIONS_H
+#define AMUNOPTIONS_H
+
+#include <QString>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class AmunThreadPool;
+
+/*!
+ * \brief Startup configuration of an Amun instance
+ *
+ * The options are either passed to the Amun constructor or set using
+ * AmunOptions::setDefault before the instance is created by AmunClient::start.
+ */
+struct AmunOptions
+{
+    static void setDefault(const AmunOptions &options);
+    static AmunOptions getDefault();
+
+    enum class NetworkBackend {
+        //! one Receiver per socket on the shared network thread
+        Qt,
+        //! recvmmsg based receivers on a dedicated thread, Linux only
+        Batched
+    };
+
+    //! Scheduling of one of the threads created by Amun, Linux only
+    struct ThreadOptions {
+        //! cpus the thread may run on, empty to use every cpu that is not isolated
+        std::vector<int> cpus;
+        //! SCHED_FIFO priority (1 - 99), 0 keeps the default scheduling policy
+        int realtimePriority = 0;
+        std::optional<int> nice;
+    };
+
+    NetworkBackend networkBackend = NetworkBackend::Qt;
+    //! only pass the freshest world state to the strategy and the tracker publisher
+    //! instead of queueing every frame if they fall behind
+    bool latestWinsDelivery = false;
+    //! reloads start a second autoref on a background thread, which replaces the
+    //! running one once it has handled some frames, not supported with a thread pool
+    bool backgroundReload = false;
+
+    ThreadOptions processorThread;
+    ThreadOptions networkThread;
+    ThreadOptions networkEngineThread;
+    ThreadOptions autorefThread;
+    //! cpus reserved for threads that are explicitly pinned to them
+    std::vector<int> isolatedCpus;
+
+    //! threads shared with other instances, the instance creates its own threads if unset
+    std::shared_ptr<AmunThreadPool> threadPool;
+    //! index of the instance, selects its worker thread in the thread pool
+    int instance = 0;
+
+    ThreadOptions *threadOptions(const QString &name);
+    bool loadThreadConfig(const QString &filename, QString &error);
+    static bool parseCpuList(const QString &list, std::vector<int> &cpus);
+    static bool parseThreadOptions(const QString &spec, ThreadOptions &options);
+};
+
+#endif // AMUNOPTIONS_H
@@ -0,0 +1,74 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef AMUNTHREADPOOL_H
+#define AMUNTHREADPOOL_H
+
+#include "amunoptions.h"
+#include "protobuf/status.h"
+#include <QMutex>
+#include <memory>
+#include <vector>
+
+class QThread;
+class ThreadTopology;
+
+/*!
+ * \brief Threads shared by several Amun instances in one process
+ *
+ * Half of the workers run processors and use the processor thread options,
+ * the other half runs strategies and uses the autoref thread options. Thus a
+ * busy strategy never shares a worker with the tracking, unless the pool only
+ * has one worker. The instances are distributed round robin over the workers
+ * of each role. The network threads are shared by all instances. Instances
+ * only share threads, the processor, strategy and network objects still exist
+ * once per instance. The threads are running as long as the pool exists.
+ */
+class AmunThreadPool
+{
+public:
+    AmunThreadPool(int workerCount, const AmunOptions &options);
+    ~AmunThreadPool();
+    AmunThreadPool(const AmunThreadPool&) = delete;
+    AmunThreadPool& operator=(const AmunThreadPool&) = delete;
+
+    int workerCount() const { return m_processorWorkers.size() + m_strategyWorkers.size(); }
+    //! worker thread of the processor of the instance with the given index
+    QThread *processorWorker(int instance) const { return m_processorWorkers[instance % m_processorWorkers.size()]; }
+    //! worker thread of the strategy of the instance with the given index
+    QThread *strategyWorker(int instance) const;
+    QThread *networkThread() const { return m_networkThread; }
+    //! only exists for the batched network backend
+    QThread *networkEngineThread() const { return m_networkEngineThread; }
+
+    //! adds the cpu usage of each thread since the last call, see ThreadTopology
+    void addToDebugValues(amun::DebugValues *debug, qint64 now);
+
+private:
+    std::vector<QThread *> m_processorWorkers;
+    //! empty if the pool only has one worker
+    std::vector<QThread *> m_strategyWorkers;
+    QThread *m_networkThread = nullptr;
+    QThread *m_networkEngineThread = nullptr;
+    std::unique_ptr<ThreadTopology> m_topology;
+    QMutex m_topologyMutex;
+};
+
+#endif // AMUNTHREADPOOL_H
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef CHUNKEDLOGREADER_H
+#define CHUNKEDLOGREADER_H
+
+#include "protobuf/status.h"
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+/*!
+ * \brief Reads logs written by ChunkedLogWriter
+ *
+ * The file is memory mapped. Seeking to a time is a binary search in the
+ * chunk index and only the chunk containing the time is decompressed.
+ * Statuses are read sequentially from the seek position on.
+ */
+class ChunkedLogReader
+{
+public:
+    ChunkedLogReader();
+    ~ChunkedLogReader();
+    ChunkedLogReader(const ChunkedLogReader&) = delete;
+    ChunkedLogReader& operator=(const ChunkedLogReader&) = delete;
+
+    static bool isChunkedLog(const QString &filename);
+
+    bool open(const QString &filename);
+    void close();
+    QString errorMsg() const { return m_errorMsg; }
+
+    int chunkCount() const { return m_chunks.size(); }
+    qint64 statusCount() const { return m_statusCount; }
+    qint64 startTime() const;
+    qint64 endTime() const;
+
+    //! continue reading at the first status not older than time
+    bool seek(qint64 time);
+    bool atEnd() const;
+    Status readStatus();
+
+private:
+    //! a chunk header or index entry, see chunkedlogformat.h
+    struct Chunk {
+        quint64 offset;
+        quint32 compressedSize;
+        quint32 statusCount;
+        qint64 firstTime;
+        qint64 lastTime;
+    };
+
+    bool readIndex();
+    bool scanChunks();
+    bool loadChunk(int chunk);
+    Status parseNextStatus();
+
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    QString m_errorMsg;
+    std::vector<Chunk> m_chunks;
+    qint64 m_statusCount = 0;
+
+    int m_currentChunk = -1;
+    QByteArray m_chunkData;
+    int m_chunkPos = 0;
+};
+
+#endif // CHUNKEDLOGREADER_H
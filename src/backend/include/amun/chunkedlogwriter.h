@@ -0,0 +1,84 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef CHUNKEDLOGWRITER_H
+#define CHUNKEDLOGWRITER_H
+
+#include "protobuf/status.h"
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QString>
+
+/*!
+ * \brief Writes statuses to a log of independently compressed chunks
+ *
+ * Statuses are collected until a chunk is large enough or spans enough time,
+ * the chunk is then compressed and appended to the file. A time index of all
+ * chunks is written on close, which allows ChunkedLogReader to seek to any
+ * time without reading the preceding chunks.
+ */
+class ChunkedLogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        //! uncompressed bytes after which a chunk is written
+        int chunkBytes = 1 << 20;
+        //! span of status times after which a chunk is written, in nanoseconds
+        qint64 chunkDuration = 2000000000LL;
+        //! zlib compression level from 0 to 9, -1 for the default
+        int compressionLevel = -1;
+    };
+
+public:
+    explicit ChunkedLogWriter(QObject *parent = nullptr);
+    explicit ChunkedLogWriter(const Options &options, QObject *parent = nullptr);
+    ~ChunkedLogWriter() override;
+    ChunkedLogWriter(const ChunkedLogWriter&) = delete;
+    ChunkedLogWriter& operator=(const ChunkedLogWriter&) = delete;
+
+    bool open(const QString &filename);
+    bool close();
+    bool flush();
+    bool isOpen() const { return m_file.isOpen(); }
+    QString errorMsg() const { return m_errorMsg; }
+
+public slots:
+    bool writeStatus(const Status &status);
+
+private:
+    bool writeChunk();
+
+    const Options m_options;
+    QFile m_file;
+    QString m_errorMsg;
+    QByteArray m_chunk;
+    QByteArray m_serialized;
+    quint32 m_chunkStatusCount = 0;
+    qint64 m_chunkFirstTime = 0;
+    qint64 m_chunkLastTime = 0;
+    //! serialized index entries of the written chunks
+    QByteArray m_index;
+    quint32 m_chunkCount = 0;
+};
+
+#endif // CHUNKEDLOGWRITER_H
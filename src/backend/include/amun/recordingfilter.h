@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef RECORDINGFILTER_H
+#define RECORDINGFILTER_H
+
+#include "protobuf/status.h"
+#include <QHash>
+#include <QString>
+#include <QtGlobal>
+
+/*!
+ * \brief Reduces statuses to the parts selected by a recording profile
+ *
+ * The filter runs before the statuses are serialized. Parts that are not
+ * recorded are never copied, statuses which are recorded completely are
+ * passed on without a copy.
+ */
+class RecordingFilter
+{
+public:
+    enum class Profile {
+        //! every status including the complete debug output
+        Full,
+        //! game state, world state, team configurations and log messages
+        Decisions,
+        //! like full, but the debug output of each source at most with the debug rate
+        DecimatedDebug
+    };
+
+public:
+    explicit RecordingFilter(Profile profile = Profile::Full, double debugRate = 10);
+
+    //! parses full, decisions or debug:<rate in Hz>
+    static bool parse(const QString &spec, Profile &profile, double &debugRate);
+    QString toString() const;
+
+    Profile profile() const { return m_profile; }
+    double debugRate() const { return m_debugRate; }
+
+    //! returns the status to record, null if nothing of it is recorded
+    Status filter(const Status &status);
+
+private:
+    Status reduce(const Status &status);
+
+    const Profile m_profile;
+    const double m_debugRate;
+    qint64 m_debugInterval;
+    QHash<int, qint64> m_lastDebugTime;
+};
+
+#endif // RECORDINGFILTER_H
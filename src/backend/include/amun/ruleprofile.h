@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef RULEPROFILE_H
+#define RULEPROFILE_H
+
+#include "protobuf/status.h"
+#include <map>
+#include <string>
+
+/*!
+ * \brief Per rule profile published by the autoref below "Rule profile/<rule>"
+ *
+ * The values are totals over the sampled frames, see autoref/ruleprofiler.lua.
+ */
+struct RuleProfile
+{
+    float calls = 0;
+    float total = 0; //!< ms
+    float mean = 0; //!< ms
+    float max = 0; //!< ms
+    float allocated = 0; //!< bytes
+};
+
+void updateRuleProfiles(const Status &status, std::map<std::string, RuleProfile> &profiles);
+
+#endif // RULEPROFILE_H
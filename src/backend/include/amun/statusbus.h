@@ -0,0 +1,143 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef STATUSBUS_H
+#define STATUSBUS_H
+
+#include "protobuf/status.h"
+#include <QFlags>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Timer;
+
+/*!
+ * \brief Distributes statuses to subscribers that declared the fields they consume
+ *
+ * A status is only delivered to a subscriber if it contains at least one of
+ * the subscribed fields, statuses without any of them neither cause a call nor
+ * a queued event. Subscribers living in another thread are invoked using a
+ * queued call, otherwise the handler is called directly.
+ *
+ * Subscribers with latest-wins delivery have a mailbox instead of one queued
+ * call per status. A pending status that only carries world and game state is
+ * replaced by a newer one of that kind, thus a slow subscriber always handles
+ * the freshest world state. Statuses with any other content are never dropped.
+ *
+ * The thread of a receiver is resolved when it subscribes, thus it has to be
+ * moved to its final thread before. The publishing thread never touches a
+ * receiver of another thread, its deliveries are posted to a context object
+ * of the bus in that thread. Whether the receiver still exists is only checked
+ * there, so a receiver may be deleted in its own thread at any time.
+ *
+ * The subscriber list is copied on modification, thus subscribe, unsubscribe
+ * and rename may be called from any thread while statuses are published.
+ * A publish that is already running still delivers to the previous list.
+ * The statistics may be read from any thread.
+ */
+class StatusBus : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Field : quint32 {
+        WorldState = 1 << 0,
+        GameState = 1 << 1,
+        Debug = 1 << 2,
+        Teams = 1 << 3,
+        StrategyAutoref = 1 << 4,
+        AmunState = 1 << 5,
+        //! set for statuses that contain none of the fields above
+        Other = 0x80000000,
+        All = 0xFFFFFFFF
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    enum class Delivery {
+        //! every status is delivered
+        Queued,
+        //! pending world states are replaced by newer ones
+        LatestWins
+    };
+
+    struct SubscriberStatistics {
+        QString name;
+        //! statuses delivered since the last reset
+        quint64 delivered;
+        //! statuses skipped as none of the fields matched since the last reset
+        quint64 skipped;
+        //! statuses replaced by a newer one before being handled since the last reset
+        quint64 dropped;
+        //! queued deliveries that were not handled yet
+        int queueDepth;
+        int maxQueueDepth;
+        //! age of the handled world states since the last reset, zero without a timer
+        qint64 meanFrameAge;
+        qint64 maxFrameAge;
+    };
+
+public:
+    explicit StatusBus(const Timer *timer = nullptr, QObject *parent = nullptr);
+    ~StatusBus() override;
+    StatusBus(const StatusBus&) = delete;
+    StatusBus& operator=(const StatusBus&) = delete;
+
+    static Fields fieldsOf(const Status &status);
+
+    template <typename Receiver>
+    void subscribe(const QString &name, Fields fields, Receiver *receiver, void (Receiver::*slot)(const Status &),
+                   Delivery delivery = Delivery::Queued)
+    {
+        subscribe(name, fields, receiver, [receiver, slot](const Status &status) {
+            (receiver->*slot)(status);
+        }, delivery);
+    }
+    void subscribe(const QString &name, Fields fields, QObject *receiver, std::function<void(const Status &)> handler,
+                   Delivery delivery = Delivery::Queued);
+    void unsubscribe(QObject *receiver);
+    void rename(QObject *receiver, const QString &name);
+
+    std::vector<SubscriberStatistics> statistics();
+    void addToDebugValues(amun::DebugValues *debug);
+
+public slots:
+    void publish(const Status &status);
+
+private:
+    struct Subscriber;
+    void postToMailbox(const std::shared_ptr<Subscriber> &subscriber, const Status &status);
+    static void handle(const Timer *timer, Subscriber *subscriber, const Status &status);
+
+    using SubscriberList = std::vector<std::shared_ptr<Subscriber>>;
+    std::shared_ptr<const SubscriberList> subscribers() const;
+
+    const Timer *m_timer;
+    mutable QMutex m_subscribersMutex;
+    std::shared_ptr<const SubscriberList> m_subscribers;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(StatusBus::Fields)
+
+#endif // STATUSBUS_H
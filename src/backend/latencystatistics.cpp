@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "latencystatistics.h"
+#include <algorithm>
+
+LatencyStatistics::LatencyStatistics(std::size_t maxSamples) :
+    m_maxSamples(maxSamples)
+{
+}
+
+void LatencyStatistics::addSample(const std::string &stage, qint64 latency)
+{
+    // there are only a handful of stages, thus a linear search is fastest
+    auto it = std::find_if(m_stages.begin(), m_stages.end(), [&stage](const Stage &s) { return s.name == stage; });
+    if (it == m_stages.end()) {
+        m_stages.emplace_back();
+        it = m_stages.end() - 1;
+        it->name = stage;
+        it->samples.reserve(m_maxSamples);
+    }
+
+    if (it->samples.size() < m_maxSamples) {
+        it->samples.push_back(latency);
+    } else {
+        // replace a random sample with probability maxSamples / (count + 1),
+        // which keeps a uniformly random subset of all samples of the interval
+        const qint64 index = std::uniform_int_distribution<qint64>(0, it->count)(m_random);
+        if (index < qint64(m_maxSamples)) {
+            it->samples[index] = latency;
+        }
+    }
+    it->count++;
+    it->max = std::max(it->max, latency);
+}
+
+bool LatencyStatistics::isEmpty() const
+{
+    return std::none_of(m_stages.begin(), m_stages.end(), [](const Stage &s) { return s.count > 0; });
+}
+
+static qint64 percentile(std::vector<qint64> &samples, double fraction)
+{
+    const std::size_t index = std::min<std::size_t>(samples.size() * fraction, samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void LatencyStatistics::addToDebugValues(amun::DebugValues *debug)
+{
+    for (Stage &stage : m_stages) {
+        if (stage.samples.empty()) {
+            continue;
+        }
+        const std::string prefix = "Latency [ms]/" + stage.name + "/";
+        auto addValue = [debug, &prefix](const char *name, qint64 latency) {
+            amun::DebugValue *value = debug->add_value();
+            value->set_key(prefix + name);
+            value->set_float_value(latency * 1E-6f);
+        };
+        addValue("p50", percentile(stage.samples, 0.5));
+        addValue("p99", percentile(stage.samples, 0.99));
+        addValue("max", stage.max);
+
+        stage.samples.clear();
+        stage.count = 0;
+        stage.max = 0;
+    }
+}
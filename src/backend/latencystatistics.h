@@ -0,0 +1,60 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef LATENCYSTATISTICS_H
+#define LATENCYSTATISTICS_H
+
+#include "protobuf/status.h"
+#include <QtGlobal>
+#include <random>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Collects latency samples per processing stage
+ *
+ * The samples of every stage are summarized as p50, p99 and max and
+ * written as debug values below "Latency [ms]/<stage>". Each call to
+ * addToDebugValues starts a new measurement interval. If an interval has
+ * more samples than fit into the buffer, a uniformly random subset of them
+ * is kept (reservoir sampling), the max is always exact.
+ */
+class LatencyStatistics
+{
+public:
+    explicit LatencyStatistics(std::size_t maxSamples = 2048);
+
+    void addSample(const std::string &stage, qint64 latency);
+    void addToDebugValues(amun::DebugValues *debug);
+    bool isEmpty() const;
+
+private:
+    struct Stage {
+        std::string name;
+        std::vector<qint64> samples;
+        qint64 count = 0;
+        qint64 max = 0;
+    };
+
+    std::size_t m_maxSamples;
+    std::minstd_rand m_random;
+    std::vector<Stage> m_stages;
+};
+
+#endif // LATENCYSTATISTICS_H
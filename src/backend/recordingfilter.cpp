@@ -0,0 +1,188 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "recordingfilter.h"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include <algorithm>
+#include <vector>
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+
+// status fields recorded by the decisions profile besides the log messages
+static bool isDecisionField(const FieldDescriptor *field)
+{
+    static const char *const NAMES[] = { "time", "game_state", "world_state", "geometry", "team_yellow", "team_blue" };
+    for (const char *name : NAMES) {
+        if (field->name() == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void copyField(const Message &from, Message *to, const FieldDescriptor *field)
+{
+    const Reflection *source = from.GetReflection();
+    const Reflection *target = to->GetReflection();
+    if (field->is_repeated()) {
+        const int size = source->FieldSize(from, field);
+        for (int i = 0; i < size; i++) {
+            switch (field->cpp_type()) {
+            case FieldDescriptor::CPPTYPE_MESSAGE:
+                target->AddMessage(to, field)->CopyFrom(source->GetRepeatedMessage(from, field, i));
+                break;
+            case FieldDescriptor::CPPTYPE_STRING:
+                target->AddString(to, field, source->GetRepeatedString(from, field, i));
+                break;
+            default:
+                // there are no repeated scalars in the status, these are not recorded
+                break;
+            }
+        }
+        return;
+    }
+
+    switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32: target->SetInt32(to, field, source->GetInt32(from, field)); break;
+    case FieldDescriptor::CPPTYPE_INT64: target->SetInt64(to, field, source->GetInt64(from, field)); break;
+    case FieldDescriptor::CPPTYPE_UINT32: target->SetUInt32(to, field, source->GetUInt32(from, field)); break;
+    case FieldDescriptor::CPPTYPE_UINT64: target->SetUInt64(to, field, source->GetUInt64(from, field)); break;
+    case FieldDescriptor::CPPTYPE_DOUBLE: target->SetDouble(to, field, source->GetDouble(from, field)); break;
+    case FieldDescriptor::CPPTYPE_FLOAT: target->SetFloat(to, field, source->GetFloat(from, field)); break;
+    case FieldDescriptor::CPPTYPE_BOOL: target->SetBool(to, field, source->GetBool(from, field)); break;
+    case FieldDescriptor::CPPTYPE_ENUM: target->SetEnumValue(to, field, source->GetEnumValue(from, field)); break;
+    case FieldDescriptor::CPPTYPE_STRING: target->SetString(to, field, source->GetString(from, field)); break;
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+        target->MutableMessage(to, field)->CopyFrom(source->GetMessage(from, field));
+        break;
+    }
+}
+
+RecordingFilter::RecordingFilter(Profile profile, double debugRate) :
+    m_profile(profile),
+    m_debugRate(debugRate),
+    m_debugInterval(debugRate > 0 ? qint64(1E9 / debugRate) : 0)
+{
+}
+
+bool RecordingFilter::parse(const QString &spec, Profile &profile, double &debugRate)
+{
+    if (spec == "full") {
+        profile = Profile::Full;
+        return true;
+    }
+    if (spec == "decisions") {
+        profile = Profile::Decisions;
+        return true;
+    }
+    if (spec.startsWith("debug:")) {
+        bool ok = false;
+        const double rate = spec.mid(6).toDouble(&ok);
+        if (!ok || rate <= 0) {
+            return false;
+        }
+        profile = Profile::DecimatedDebug;
+        debugRate = rate;
+        return true;
+    }
+    return false;
+}
+
+QString RecordingFilter::toString() const
+{
+    switch (m_profile) {
+    case Profile::Full:
+        return "full";
+    case Profile::Decisions:
+        return "decisions";
+    case Profile::DecimatedDebug:
+        return QString("debug:%1").arg(m_debugRate);
+    }
+    return QString();
+}
+
+Status RecordingFilter::filter(const Status &status)
+{
+    Status recorded = status;
+    if (m_profile == Profile::Decisions) {
+        recorded = reduce(status);
+    } else if (m_profile == Profile::DecimatedDebug && status->debug_size() > 0) {
+        bool fullDebug = true;
+        for (const amun::DebugValues &debug : status->debug()) {
+            qint64 &lastTime = m_lastDebugTime[debug.source()];
+            if (status->time() - lastTime < m_debugInterval) {
+                fullDebug = false;
+            }
+        }
+        if (fullDebug) {
+            for (const amun::DebugValues &debug : status->debug()) {
+                m_lastDebugTime[debug.source()] = status->time();
+            }
+        } else {
+            recorded = reduce(status);
+        }
+    }
+    return recorded;
+}
+
+/*!
+ * \brief Copies the recorded parts of a status
+ *
+ * Debug outputs are reduced to their log messages. Returns the status itself
+ * if it is recorded completely and null if only the time would remain.
+ */
+Status RecordingFilter::reduce(const Status &status)
+{
+    static const FieldDescriptor *debugField = amun::Status::descriptor()->FindFieldByName("debug");
+    static const FieldDescriptor *timeField = amun::Status::descriptor()->FindFieldByName("time");
+
+    thread_local std::vector<const FieldDescriptor *> fields;
+    fields.clear();
+    status->GetReflection()->ListFields(*status, &fields);
+
+    const bool isComplete = std::all_of(fields.begin(), fields.end(), [this](const FieldDescriptor *field) {
+        return field != debugField && (m_profile != Profile::Decisions || isDecisionField(field));
+    });
+    if (isComplete) {
+        return fields.size() == 1 && fields[0] == timeField ? Status() : status;
+    }
+
+    Status reduced(new amun::Status);
+    bool hasContent = false;
+    for (const FieldDescriptor *field : fields) {
+        if (field == debugField) {
+            for (const amun::DebugValues &debug : status->debug()) {
+                if (debug.log_size() > 0) {
+                    amun::DebugValues *logOnly = reduced->add_debug();
+                    logOnly->set_source(debug.source());
+                    *logOnly->mutable_log() = debug.log();
+                    hasContent = true;
+                }
+            }
+        } else if (m_profile != Profile::Decisions || isDecisionField(field)) {
+            copyField(*status, reduced.get(), field);
+            hasContent |= field != timeField;
+        }
+    }
+    return hasContent ? reduced : Status();
+}
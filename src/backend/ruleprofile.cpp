@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ruleprofile.h"
+
+/*!
+ * \brief Updates the profiles with the rule profile values of the autoref in the status
+ *
+ * Rules without values in the status keep their previous profile.
+ */
+void updateRuleProfiles(const Status &status, std::map<std::string, RuleProfile> &profiles)
+{
+    static const std::string PREFIX = "Rule profile/";
+
+    for (const amun::DebugValues &debug : status->debug()) {
+        if (debug.source() != amun::Autoref) {
+            continue;
+        }
+        for (const amun::DebugValue &value : debug.value()) {
+            const std::string &key = value.key();
+            const std::size_t split = key.rfind('/');
+            if (key.compare(0, PREFIX.size(), PREFIX) != 0 || split < PREFIX.size()) {
+                continue;
+            }
+            RuleProfile &profile = profiles[key.substr(PREFIX.size(), split - PREFIX.size())];
+            const std::string quantity = key.substr(split + 1);
+            if (quantity == "calls") {
+                profile.calls = value.float_value();
+            } else if (quantity == "total [ms]") {
+                profile.total = value.float_value();
+            } else if (quantity == "mean [ms]") {
+                profile.mean = value.float_value();
+            } else if (quantity == "max [ms]") {
+                profile.max = value.float_value();
+            } else if (quantity == "allocated [B]") {
+                profile.allocated = value.float_value();
+            }
+        }
+    }
+}
@@ -0,0 +1,322 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "statusbus.h"
+#include "core/timer.h"
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <google/protobuf/descriptor.h>
+
+/*!
+ * \brief Checks whether the status only carries world state, game state and time
+ *
+ * Such a status is fully superseded by the next one of its kind. Reflection
+ * is used, as a status may contain fields which the bus does not know about.
+ */
+static bool isSupersedable(const Status &status)
+{
+    using google::protobuf::FieldDescriptor;
+    static const FieldDescriptor *timeField = amun::Status::descriptor()->FindFieldByName("time");
+    static const FieldDescriptor *worldStateField = amun::Status::descriptor()->FindFieldByName("world_state");
+    static const FieldDescriptor *gameStateField = amun::Status::descriptor()->FindFieldByName("game_state");
+
+    thread_local std::vector<const FieldDescriptor*> fields;
+    fields.clear();
+    status->GetReflection()->ListFields(*status, &fields);
+    return std::all_of(fields.begin(), fields.end(), [](const FieldDescriptor *field) {
+        return field == timeField || field == worldStateField || field == gameStateField;
+    });
+}
+
+static void updateMaximum(std::atomic<qint64> &maximum, qint64 value)
+{
+    qint64 current = maximum.load(std::memory_order_relaxed);
+    while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) { }
+}
+
+struct StatusBus::Subscriber
+{
+    QString name;
+    Fields fields;
+    Delivery delivery;
+    //! only dereferenced in the thread of the receiver
+    QPointer<QObject> receiver;
+    //! resolved when subscribing, as the receiver may be deleted concurrently to a publish
+    QThread *thread;
+    //! lives in the thread of the receiver and is the target of queued deliveries
+    std::shared_ptr<QObject> context;
+    std::function<void(const Status &)> handler;
+
+    std::atomic<quint64> delivered { 0 };
+    std::atomic<quint64> skipped { 0 };
+    std::atomic<quint64> dropped { 0 };
+    //! decremented by the receiving thread
+    std::atomic<int> queueDepth { 0 };
+    std::atomic<qint64> maxQueueDepth { 0 };
+    std::atomic<qint64> frameAgeSum { 0 };
+    std::atomic<qint64> frameAgeCount { 0 };
+    std::atomic<qint64> maxFrameAge { 0 };
+
+    // latest-wins delivery only
+    QMutex mailboxMutex;
+    std::deque<Status> mailbox;
+    bool lastMailboxSupersedable = false;
+};
+
+StatusBus::StatusBus(const Timer *timer, QObject *parent) :
+    QObject(parent),
+    m_timer(timer),
+    m_subscribers(std::make_shared<const SubscriberList>())
+{ }
+
+StatusBus::~StatusBus() = default;
+
+/*!
+ * \brief Returns the subscribable fields that are set in the status
+ */
+StatusBus::Fields StatusBus::fieldsOf(const Status &status)
+{
+    Fields fields;
+    if (status->has_world_state()) {
+        fields |= WorldState;
+    }
+    if (status->has_game_state()) {
+        fields |= GameState;
+    }
+    if (status->debug_size() > 0) {
+        fields |= Debug;
+    }
+    if (status->has_team_yellow() || status->has_team_blue()) {
+        fields |= Teams;
+    }
+    if (status->has_strategy_autoref()) {
+        fields |= StrategyAutoref;
+    }
+    if (status->has_amun_state()) {
+        fields |= AmunState;
+    }
+    if (!fields) {
+        fields |= Other;
+    }
+    return fields;
+}
+
+/*!
+ * \brief Subscribes a handler that is called in the thread of the receiver
+ *
+ * The handler is no longer called once the receiver is destroyed.
+ */
+void StatusBus::subscribe(const QString &name, Fields fields, QObject *receiver,
+                          std::function<void(const Status &)> handler, Delivery delivery)
+{
+    std::shared_ptr<Subscriber> subscriber(new Subscriber);
+    subscriber->name = name;
+    subscriber->fields = fields;
+    subscriber->delivery = delivery;
+    subscriber->receiver = receiver;
+    subscriber->thread = receiver->thread();
+    // deleteLater is safe to call from any thread
+    subscriber->context.reset(new QObject, [](QObject *context) { context->deleteLater(); });
+    subscriber->context->moveToThread(subscriber->thread);
+    subscriber->handler = std::move(handler);
+
+    QMutexLocker locker(&m_subscribersMutex);
+    auto subscribers = std::make_shared<SubscriberList>(*m_subscribers);
+    subscribers->push_back(subscriber);
+    m_subscribers = std::move(subscribers);
+}
+
+/*!
+ * \brief Removes every subscription of the receiver
+ */
+void StatusBus::unsubscribe(QObject *receiver)
+{
+    QMutexLocker locker(&m_subscribersMutex);
+    auto subscribers = std::make_shared<SubscriberList>(*m_subscribers);
+    subscribers->erase(std::remove_if(subscribers->begin(), subscribers->end(),
+            [receiver](const std::shared_ptr<Subscriber> &s) { return s->receiver == receiver || s->receiver.isNull(); }),
+            subscribers->end());
+    m_subscribers = std::move(subscribers);
+}
+
+/*!
+ * \brief Changes the name under which the statistics of the receiver are reported
+ */
+void StatusBus::rename(QObject *receiver, const QString &name)
+{
+    QMutexLocker locker(&m_subscribersMutex);
+    auto subscribers = std::make_shared<SubscriberList>();
+    for (const std::shared_ptr<Subscriber> &subscriber : *m_subscribers) {
+        if (subscriber->receiver != receiver) {
+            subscribers->push_back(subscriber);
+            continue;
+        }
+        // the subscriber is shared with running publishes, thus only the copy is renamed
+        std::shared_ptr<Subscriber> renamed(new Subscriber);
+        renamed->name = name;
+        renamed->fields = subscriber->fields;
+        renamed->delivery = subscriber->delivery;
+        renamed->receiver = subscriber->receiver;
+        renamed->thread = subscriber->thread;
+        renamed->context = subscriber->context;
+        renamed->handler = subscriber->handler;
+        subscribers->push_back(renamed);
+    }
+    m_subscribers = std::move(subscribers);
+}
+
+std::shared_ptr<const StatusBus::SubscriberList> StatusBus::subscribers() const
+{
+    QMutexLocker locker(&m_subscribersMutex);
+    return m_subscribers;
+}
+
+void StatusBus::publish(const Status &status)
+{
+    const Fields fields = fieldsOf(status);
+    const std::shared_ptr<const SubscriberList> subscribers = this->subscribers();
+    for (const std::shared_ptr<Subscriber> &subscriber : *subscribers) {
+        if (!(subscriber->fields & fields)) {
+            subscriber->skipped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        subscriber->delivered.fetch_add(1, std::memory_order_relaxed);
+
+        if (subscriber->thread == QThread::currentThread()) {
+            if (subscriber->receiver) {
+                subscriber->handler(status);
+            }
+        } else if (subscriber->delivery == Delivery::LatestWins) {
+            postToMailbox(subscriber, status);
+        } else {
+            const int depth = ++subscriber->queueDepth;
+            updateMaximum(subscriber->maxQueueDepth, depth);
+            // the subscriber is kept alive until the queued call is handled
+            QMetaObject::invokeMethod(subscriber->context.get(), [timer = m_timer, subscriber, status]() {
+                subscriber->queueDepth--;
+                handle(timer, subscriber.get(), status);
+            }, Qt::QueuedConnection);
+        }
+    }
+}
+
+void StatusBus::postToMailbox(const std::shared_ptr<Subscriber> &subscriber, const Status &status)
+{
+    const bool supersedable = isSupersedable(status);
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&subscriber->mailboxMutex);
+        wasEmpty = subscriber->mailbox.empty();
+        if (!wasEmpty && subscriber->lastMailboxSupersedable && supersedable) {
+            subscriber->mailbox.back() = status;
+            subscriber->dropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            subscriber->mailbox.push_back(status);
+            const int depth = ++subscriber->queueDepth;
+            updateMaximum(subscriber->maxQueueDepth, depth);
+        }
+        subscriber->lastMailboxSupersedable = supersedable;
+    }
+
+    // a call is already pending otherwise, which will also handle this status
+    if (wasEmpty) {
+        QMetaObject::invokeMethod(subscriber->context.get(), [timer = m_timer, subscriber]() {
+            std::deque<Status> statuses;
+            {
+                QMutexLocker locker(&subscriber->mailboxMutex);
+                statuses.swap(subscriber->mailbox);
+            }
+            subscriber->queueDepth -= statuses.size();
+            for (const Status &status : statuses) {
+                handle(timer, subscriber.get(), status);
+            }
+        }, Qt::QueuedConnection);
+    }
+}
+
+void StatusBus::handle(const Timer *timer, Subscriber *subscriber, const Status &status)
+{
+    // called in the thread of the receiver, thus it can't be deleted concurrently
+    if (!subscriber->receiver) {
+        return;
+    }
+    if (timer && status->has_world_state()) {
+        const qint64 age = timer->currentTime() - status->world_state().time();
+        subscriber->frameAgeSum.fetch_add(age, std::memory_order_relaxed);
+        subscriber->frameAgeCount.fetch_add(1, std::memory_order_relaxed);
+        updateMaximum(subscriber->maxFrameAge, age);
+    }
+    subscriber->handler(status);
+}
+
+/*!
+ * \brief Returns the statistics of every subscriber and resets them
+ */
+std::vector<StatusBus::SubscriberStatistics> StatusBus::statistics()
+{
+    std::vector<SubscriberStatistics> statistics;
+    const std::shared_ptr<const SubscriberList> subscribers = this->subscribers();
+    for (const std::shared_ptr<Subscriber> &subscriber : *subscribers) {
+        const qint64 ageCount = subscriber->frameAgeCount.exchange(0);
+        const qint64 ageSum = subscriber->frameAgeSum.exchange(0);
+        statistics.push_back({
+            subscriber->name,
+            subscriber->delivered.exchange(0),
+            subscriber->skipped.exchange(0),
+            subscriber->dropped.exchange(0),
+            subscriber->queueDepth.load(),
+            int(subscriber->maxQueueDepth.exchange(0)),
+            ageCount > 0 ? ageSum / ageCount : 0,
+            subscriber->maxFrameAge.exchange(0)
+        });
+    }
+    return statistics;
+}
+
+/*!
+ * \brief Adds the statistics of every subscriber below "Status bus/<name>"
+ *
+ * The statistics are reset afterwards.
+ */
+void StatusBus::addToDebugValues(amun::DebugValues *debug)
+{
+    for (const SubscriberStatistics &subscriber : statistics()) {
+        const std::string prefix = "Status bus/" + subscriber.name.toStdString() + "/";
+        auto addValue = [debug, &prefix](const char *key, float value) {
+            amun::DebugValue *debugValue = debug->add_value();
+            debugValue->set_key(prefix + key);
+            debugValue->set_float_value(value);
+        };
+        addValue("delivered", subscriber.delivered);
+        addValue("skipped", subscriber.skipped);
+        addValue("dropped", subscriber.dropped);
+        addValue("queue depth", subscriber.queueDepth);
+        addValue("max queue depth", subscriber.maxQueueDepth);
+        if (subscriber.maxFrameAge > 0) {
+            addValue("frame age [ms]/mean", subscriber.meanFrameAge * 1E-6f);
+            addValue("frame age [ms]/max", subscriber.maxFrameAge * 1E-6f);
+        }
+    }
+}
@@ -0,0 +1,231 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "threadtopology.h"
+#include <QDebug>
+#include <QFile>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct ThreadTopology::ManagedThread
+{
+    QThread *thread;
+    QString name;
+    AmunOptions::ThreadOptions options;
+    //! kernel thread id, set once the thread has started
+    std::atomic<qint64> tid { 0 };
+
+    // scheduler counters of the previous sample
+    qint64 lastSampleTime = 0;
+    qint64 runTime = 0;
+    qint64 waitTime = 0;
+    qint64 timeslices = 0;
+    qint64 voluntarySwitches = 0;
+    qint64 involuntarySwitches = 0;
+};
+
+ThreadTopology::ThreadTopology(const std::vector<int> &isolatedCpus) :
+    m_isolatedCpus(isolatedCpus)
+{ }
+
+ThreadTopology::~ThreadTopology() = default;
+
+/*!
+ * \brief Applies the options to the thread once it is started
+ *
+ * The name is also used as the operating system thread name, which is only
+ * set for threads that are not running yet. A running thread gets the options
+ * applied from within its event loop.
+ */
+void ThreadTopology::manage(QThread *thread, const QString &name, const AmunOptions::ThreadOptions &options)
+{
+    thread->setObjectName(name);
+    auto managed = std::make_shared<ManagedThread>();
+    managed->thread = thread;
+    managed->name = name;
+    managed->options = options;
+    m_threads.push_back(managed);
+    // the thread may be released before the options are applied
+    std::weak_ptr<ManagedThread> weakManaged = managed;
+    if (thread->isRunning()) {
+        QObject *context = new QObject;
+        context->moveToThread(thread);
+        QMetaObject::invokeMethod(context, [this, weakManaged, context]() {
+            if (auto managed = weakManaged.lock()) {
+                applyOptions(managed.get());
+            }
+            delete context;
+        }, Qt::QueuedConnection);
+        return;
+    }
+    // started is emitted from within the new thread
+    QObject::connect(thread, &QThread::started, thread, [this, weakManaged]() {
+        if (auto managed = weakManaged.lock()) {
+            applyOptions(managed.get());
+        }
+    }, Qt::DirectConnection);
+}
+
+/*!
+ * \brief Stops sampling the thread
+ *
+ * Must be called before the thread is destroyed. The scheduling settings of
+ * the thread are left unchanged.
+ */
+void ThreadTopology::release(QThread *thread)
+{
+    QObject::disconnect(thread, &QThread::started, thread, nullptr);
+    m_threads.erase(std::remove_if(m_threads.begin(), m_threads.end(),
+            [thread](const std::shared_ptr<ManagedThread> &managed) { return managed->thread == thread; }),
+            m_threads.end());
+}
+
+#ifdef Q_OS_LINUX
+void ThreadTopology::applyOptions(ManagedThread *thread)
+{
+    const pid_t tid = syscall(SYS_gettid);
+    thread->tid.store(tid);
+    const AmunOptions::ThreadOptions &options = thread->options;
+
+    // unpinned threads must stay away from the isolated cpus
+    std::vector<int> cpus = options.cpus;
+    if (cpus.empty() && !m_isolatedCpus.empty()) {
+        const int cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+        for (int cpu = 0; cpu < cpuCount; cpu++) {
+            if (std::find(m_isolatedCpus.begin(), m_isolatedCpus.end(), cpu) == m_isolatedCpus.end()) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    if (!cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (error != 0) {
+            qWarning() << "Could not set cpu affinity of thread" << thread->name << ":" << std::strerror(error);
+        }
+    }
+
+    if (options.realtimePriority > 0) {
+        sched_param param;
+        param.sched_priority = options.realtimePriority;
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (error != 0) {
+            qWarning() << "Could not set realtime priority of thread" << thread->name << ":" << std::strerror(error);
+        }
+    }
+
+    // on Linux the nice value is a per thread attribute
+    if (options.nice && setpriority(PRIO_PROCESS, tid, *options.nice) != 0) {
+        qWarning() << "Could not set nice value of thread" << thread->name << ":" << std::strerror(errno);
+    }
+}
+
+/*!
+ * \brief Adds cpu usage, context switches and wakeup latency since the last call
+ *
+ * The counters are read from /proc/self/task/<tid>/status and schedstat.
+ * The wakeup latency is the mean time spent runnable but waiting for a cpu.
+ */
+void ThreadTopology::addToDebugValues(amun::DebugValues *debug, qint64 now)
+{
+    for (const auto &thread : m_threads) {
+        const qint64 tid = thread->tid.load();
+        if (tid == 0) {
+            continue;
+        }
+        const QString taskPath = QString("/proc/self/task/%1/").arg(tid);
+
+        QFile schedstat(taskPath + "schedstat");
+        if (!schedstat.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const QList<QByteArray> times = schedstat.readAll().simplified().split(' ');
+        if (times.size() < 3) {
+            continue;
+        }
+        const qint64 runTime = times[0].toLongLong();
+        const qint64 waitTime = times[1].toLongLong();
+        const qint64 timeslices = times[2].toLongLong();
+
+        qint64 voluntarySwitches = 0;
+        qint64 involuntarySwitches = 0;
+        QFile status(taskPath + "status");
+        if (status.open(QIODevice::ReadOnly)) {
+            for (const QByteArray &line : status.readAll().split('\n')) {
+                if (line.startsWith("voluntary_ctxt_switches:")) {
+                    voluntarySwitches = line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+                } else if (line.startsWith("nonvoluntary_ctxt_switches:")) {
+                    involuntarySwitches = line.mid(line.indexOf(':') + 1).trimmed().toLongLong();
+                }
+            }
+        }
+
+        if (thread->lastSampleTime > 0 && now > thread->lastSampleTime) {
+            const float seconds = (now - thread->lastSampleTime) * 1E-9f;
+            const std::string prefix = "Threads/" + thread->name.toStdString() + "/";
+            auto addValue = [debug, &prefix](const char *key, float value) {
+                amun::DebugValue *debugValue = debug->add_value();
+                debugValue->set_key(prefix + key);
+                debugValue->set_float_value(value);
+            };
+            addValue("cpu [%]", (runTime - thread->runTime) * 1E-7f / seconds);
+            addValue("voluntary switches per second", (voluntarySwitches - thread->voluntarySwitches) / seconds);
+            addValue("involuntary switches per second", (involuntarySwitches - thread->involuntarySwitches) / seconds);
+            const qint64 slices = timeslices - thread->timeslices;
+            if (slices > 0) {
+                addValue("wakeup latency [us]", (waitTime - thread->waitTime) * 1E-3f / slices);
+            }
+        }
+
+        thread->lastSampleTime = now;
+        thread->runTime = runTime;
+        thread->waitTime = waitTime;
+        thread->timeslices = timeslices;
+        thread->voluntarySwitches = voluntarySwitches;
+        thread->involuntarySwitches = involuntarySwitches;
+    }
+}
+#else
+void ThreadTopology::applyOptions(ManagedThread *thread)
+{
+    const AmunOptions::ThreadOptions &options = thread->options;
+    if (!options.cpus.empty() || options.realtimePriority > 0 || options.nice || !m_isolatedCpus.empty()) {
+        qWarning() << "Thread options are only supported on Linux, ignoring them for thread" << thread->name;
+    }
+}
+
+void ThreadTopology::addToDebugValues(amun::DebugValues *, qint64)
+{ }
+#endif
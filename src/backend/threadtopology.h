@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef THREADTOPOLOGY_H
+#define THREADTOPOLOGY_H
+
+#include "amunoptions.h"
+#include "protobuf/status.h"
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+/*!
+ * \brief Applies cpu affinity and scheduling settings to the threads of Amun
+ *
+ * The settings are applied from within each thread once it has started, or
+ * right away if the thread is already running.
+ * Afterwards the scheduler statistics of the threads can be sampled.
+ * Everything except the thread names is only supported on Linux.
+ */
+class ThreadTopology
+{
+public:
+    explicit ThreadTopology(const std::vector<int> &isolatedCpus);
+    ~ThreadTopology();
+    ThreadTopology(const ThreadTopology&) = delete;
+    ThreadTopology& operator=(const ThreadTopology&) = delete;
+
+public:
+    void manage(QThread *thread, const QString &name, const AmunOptions::ThreadOptions &options);
+    void release(QThread *thread);
+    bool isEmpty() const { return m_threads.empty(); }
+    void addToDebugValues(amun::DebugValues *debug, qint64 now);
+
+private:
+    struct ManagedThread;
+    void applyOptions(ManagedThread *thread);
+
+    std::vector<int> m_isolatedCpus;
+    // shared, as pending option updates of running threads keep a weak reference
+    std::vector<std::shared_ptr<ManagedThread>> m_threads;
+};
+
+#endif // THREADTOPOLOGY_H
@@ -25,11 +25,53 @@
 #include <QNetworkInterface>
 #include <QUdpSocket>
 #include <QtGlobal>
+#include <cstring>
+#include <utility>
 #include <vector>
 #include <QDebug>
 
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <unistd.h>
+#endif
+
 UDPMulticaster::UDPMulticaster(const QHostAddress& address, quint16 port, QObject* parent)
 {
+#ifdef Q_OS_LINUX
+    if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+        m_fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (m_fd < 0) {
+            qWarning() << "Could not create multicast socket: " << std::strerror(errno);
+        }
+    }
+    if (m_fd >= 0) {
+        m_destination.sin_family = AF_INET;
+        m_destination.sin_port = htons(port);
+        m_destination.sin_addr.s_addr = htonl(address.toIPv4Address());
+
+        for (const QNetworkInterface& interface : QNetworkInterface::allInterfaces()) {
+            if (!(interface.flags() & QNetworkInterface::CanMulticast) || interface.index() <= 0) {
+                continue;
+            }
+
+            ControlBuffer control;
+            std::memset(&control, 0, sizeof(control));
+            cmsghdr *cmsg = reinterpret_cast<cmsghdr*>(control.data);
+            cmsg->cmsg_level = IPPROTO_IP;
+            cmsg->cmsg_type = IP_PKTINFO;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+            in_pktinfo pktinfo = {};
+            pktinfo.ipi_ifindex = interface.index();
+            std::memcpy(CMSG_DATA(cmsg), &pktinfo, sizeof(pktinfo));
+            m_control.push_back(control);
+        }
+        m_messages.resize(m_control.size());
+        m_iovecs.resize(m_control.size());
+        return;
+    }
+#endif
+
     for (const QNetworkInterface& interface : QNetworkInterface::allInterfaces()) {
         if (!(interface.flags() & QNetworkInterface::CanMulticast)) {
             continue;
@@ -43,12 +85,113 @@ UDPMulticaster::UDPMulticaster(const QHostAddress& address, quint16 port, QObjec
     }
 }
 
+UDPMulticaster::~UDPMulticaster()
+{
+    close();
+}
+
+UDPMulticaster::UDPMulticaster(UDPMulticaster&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+UDPMulticaster& UDPMulticaster::operator=(UDPMulticaster&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        m_sockets = std::move(other.m_sockets);
+        other.m_sockets.clear();
+#ifdef Q_OS_LINUX
+        m_fd = std::exchange(other.m_fd, -1);
+        m_destination = other.m_destination;
+        m_messages = std::move(other.m_messages);
+        m_iovecs = std::move(other.m_iovecs);
+        m_control = std::move(other.m_control);
+        m_errorReported = other.m_errorReported;
+#endif
+    }
+    return *this;
+}
+
+void UDPMulticaster::close()
+{
+    for (QUdpSocket* socket : m_sockets) {
+        delete socket;
+    }
+    m_sockets.clear();
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif
+}
+
+int UDPMulticaster::interfaceCount() const
+{
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        return m_messages.size();
+    }
+#endif
+    return m_sockets.size();
+}
+
 void UDPMulticaster::send(const QByteArray& data)
 {
+    send(data.constData(), data.size());
+}
+
+void UDPMulticaster::send(const char* data, qint64 size)
+{
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        // the message headers only point into this object, thus they are
+        // refreshed before every send to stay valid after a move
+        for (std::size_t i = 0; i < m_messages.size(); i++) {
+            m_iovecs[i].iov_base = const_cast<char*>(data);
+            m_iovecs[i].iov_len = size;
+
+            msghdr &header = m_messages[i].msg_hdr;
+            header.msg_name = &m_destination;
+            header.msg_namelen = sizeof(m_destination);
+            header.msg_iov = &m_iovecs[i];
+            header.msg_iovlen = 1;
+            header.msg_control = m_control[i].data;
+            header.msg_controllen = sizeof(m_control[i].data);
+            header.msg_flags = 0;
+        }
+
+        std::size_t sent = 0;
+        bool failed = false;
+        while (sent < m_messages.size()) {
+            const int result = ::sendmmsg(m_fd, m_messages.data() + sent, m_messages.size() - sent, 0);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // an interface without a route must not block the others
+                if (!m_errorReported) {
+                    qWarning() << "Could not send data: " << std::strerror(errno);
+                    m_errorReported = true;
+                }
+                failed = true;
+                sent++;
+            } else {
+                sent += result;
+            }
+        }
+        // report the next failure again once every interface works, e.g. after it came back up
+        if (!failed) {
+            m_errorReported = false;
+        }
+        return;
+    }
+#endif
+
     for (QUdpSocket* socket : m_sockets) {
-        if (socket->write(data) < 0) {
+        if (socket->write(data, size) < 0) {
             qWarning() << "Could not send data: " << socket->errorString();
         }
     }
 }
-
@@ -24,6 +24,11 @@
 #include <QtGlobal>
 #include <vector>
 
+#ifdef Q_OS_LINUX
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
 class QByteArray;
 class QHostAddress;
 class QObject;
@@ -32,10 +37,38 @@ class QUdpSocket;
 class UDPMulticaster {
 public:
     UDPMulticaster(const QHostAddress& address, quint16 port, QObject* parent = nullptr);
+    ~UDPMulticaster();
+    UDPMulticaster(const UDPMulticaster&) = delete;
+    UDPMulticaster& operator=(const UDPMulticaster&) = delete;
+    UDPMulticaster(UDPMulticaster&& other) noexcept;
+    UDPMulticaster& operator=(UDPMulticaster&& other) noexcept;
 
     void send(const QByteArray& data);
+    void send(const char* data, qint64 size);
+    int interfaceCount() const;
+
+private:
+    void close();
+
 private:
     std::vector<QUdpSocket*> m_sockets;
+
+#ifdef Q_OS_LINUX
+    // a single socket is used for all interfaces, the outgoing interface
+    // is selected per message using IP_PKTINFO. This allows to send the
+    // packet on every interface with one sendmmsg call
+    struct ControlBuffer {
+        alignas(cmsghdr) char data[CMSG_SPACE(sizeof(in_pktinfo))];
+    };
+
+    int m_fd = -1;
+    sockaddr_in m_destination = {};
+    std::vector<mmsghdr> m_messages;
+    std::vector<iovec> m_iovecs;
+    std::vector<ControlBuffer> m_control;
+    //! reset once a send succeeds on every interface
+    bool m_errorReported = false;
+#endif
 };
 
 #endif // UDPMULTICASTER_H
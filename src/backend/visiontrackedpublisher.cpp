@@ -21,11 +21,17 @@
 #include "visiontrackedpublisher.h"
 #include <QHostAddress>
 #include <QUdpSocket>
+#include <algorithm>
 
 #include "core/sslprotocols.h"
+#include "core/timer.h"
 
-VisionTrackedPublisher::VisionTrackedPublisher(QObject *parent) :
+// interval in which the publishing statistics are reported, in nanoseconds
+static const qint64 STATISTICS_INTERVAL = 1000000000LL;
+
+VisionTrackedPublisher::VisionTrackedPublisher(const Timer *timer, QObject *parent) :
     QObject(parent),
+    m_timer(timer),
     m_multicaster(QHostAddress(SSL_VISION_TRACKER_ADDRESS), SSL_VISION_TRACKER_PORT, parent)
 {
 }
@@ -37,19 +43,58 @@ void VisionTrackedPublisher::setFlip(bool flip)
 
 void VisionTrackedPublisher::handleStatus(const Status &status)
 {
-    const static QHostAddress TRACKED_VISION_MULTICAST { SSL_VISION_TRACKER_ADDRESS };
-
-    if (status->has_world_state()) {
-        gameController::TrackerWrapperPacket packet;
-        m_visionTracked.createTrackedFrame(status->world_state(), &packet);
-        QByteArray data;
-        data.resize(packet.ByteSize());
-        if (packet.SerializeToArray(data.data(), data.size())) {
-            m_multicaster.send(data);
-        }
+    if (!status->has_world_state()) {
+        return;
+    }
+
+    // Clear keeps the allocated submessages and strings of the previous frame,
+    // thus the packet is updated in place once it has reached its steady state size
+    m_packet.Clear();
+    m_visionTracked.createTrackedFrame(status->world_state(), &m_packet);
+    const int size = m_packet.ByteSizeLong();
+    if (m_buffer.size() < size) {
+        m_buffer.resize(size);
+    }
+    if (!m_packet.SerializeToArray(m_buffer.data(), size)) {
+        return;
+    }
+    m_multicaster.send(m_buffer.constData(), size);
+
+    const qint64 now = m_timer->currentTime();
+    m_publishedFrames++;
+    m_publishedBytes += size;
+    m_latency.addSample("tracking to tracker publish", now - status->world_state().time());
+
+    if (m_statisticsStart == 0) {
+        m_statisticsStart = now;
+    } else if (now - m_statisticsStart >= STATISTICS_INTERVAL) {
+        publishStatistics(now);
     }
 }
 
+void VisionTrackedPublisher::publishStatistics(qint64 currentTime)
+{
+    Status status(new amun::Status);
+    amun::DebugValues *debug = status->add_debug();
+    debug->set_source(amun::Controller);
+
+    auto addValue = [debug](const char *key, float value) {
+        amun::DebugValue *debugValue = debug->add_value();
+        debugValue->set_key(key);
+        debugValue->set_float_value(value);
+    };
+    const double frames = std::max<qint64>(m_publishedFrames, 1);
+    addValue("Tracked vision/bytes per frame", m_publishedBytes / frames);
+    addValue("Tracked vision/frames per second", m_publishedFrames * 1E9 / (currentTime - m_statisticsStart));
+    addValue("Tracked vision/interfaces", m_multicaster.interfaceCount());
+    m_latency.addToDebugValues(debug);
+    emit sendStatus(status);
+
+    m_statisticsStart = currentTime;
+    m_publishedFrames = 0;
+    m_publishedBytes = 0;
+}
+
 void VisionTrackedPublisher::updatePort(qint16 port)
 {
     m_multicaster = UDPMulticaster(QHostAddress(SSL_VISION_TRACKER_ADDRESS), port, this->parent());
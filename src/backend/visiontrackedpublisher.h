@@ -21,18 +21,26 @@
 #ifndef VISIONTRACKEDPUBLISHER_H
 #define VISIONTRACKEDPUBLISHER_H
 
+#include <QByteArray>
 #include <QObject>
 #include "gamecontroller/sslvisiontracked.h"
 #include "protobuf/status.h"
 
+#include "latencystatistics.h"
 #include "udpmulticaster.h"
 
 class QUdpSocket;
+class Timer;
 
 class VisionTrackedPublisher : public QObject
 {
+    Q_OBJECT
+
 public:
-    VisionTrackedPublisher(QObject *parent = nullptr);
+    VisionTrackedPublisher(const Timer *timer, QObject *parent = nullptr);
+
+signals:
+    void sendStatus(const Status &status);
 
 public slots:
     void setFlip(bool flip);
@@ -40,8 +48,21 @@ public slots:
     void updatePort(qint16 port);
 
 private:
+    void publishStatistics(qint64 currentTime);
+
+private:
+    const Timer *m_timer;
     SSLVisionTracked m_visionTracked;
     UDPMulticaster m_multicaster;
+
+    // reused for every frame to avoid allocations while publishing
+    gameController::TrackerWrapperPacket m_packet;
+    QByteArray m_buffer;
+
+    qint64 m_statisticsStart = 0;
+    qint64 m_publishedFrames = 0;
+    qint64 m_publishedBytes = 0;
+    LatencyStatistics m_latency;
 };
 
 #endif // VISIONTRACKEDPUBLISHER_H
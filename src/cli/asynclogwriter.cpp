@@ -0,0 +1,323 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "asynclogwriter.h"
+#include "amun/chunkedlogwriter.h"
+#include "seshat/logfilewriter.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <chrono>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static const int FLUSH_INTERVAL = 1000; // ms
+
+static bool writeToWriter(ChunkedLogWriter &writer, const Status &status)
+{
+    return writer.writeStatus(status);
+}
+
+static bool writeToWriter(LogFileWriter &writer, const Status &status)
+{
+    writer.writeStatus(status);
+    return true;
+}
+
+static bool closeWriter(ChunkedLogWriter &writer)
+{
+    return writer.close();
+}
+
+static bool closeWriter(LogFileWriter &writer)
+{
+    writer.close();
+    return true;
+}
+
+static QString writerError(ChunkedLogWriter &writer)
+{
+    return writer.errorMsg();
+}
+
+static QString writerError(LogFileWriter &)
+{
+    return QString();
+}
+
+static bool flushWriter(ChunkedLogWriter &writer, const QString &)
+{
+    return writer.flush();
+}
+
+// LogFileWriter has no flush of its own, thus only the data it already passed
+// to the operating system is forced to disk
+static bool flushWriter(LogFileWriter &, const QString &filename)
+{
+#ifdef Q_OS_UNIX
+    const int fd = ::open(QFile::encodeName(filename).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    Q_UNUSED(filename);
+#endif
+    return true;
+}
+
+AsyncLogWriter::AsyncLogWriter(const QString &filename, const Options &options) :
+    m_filename(filename),
+    m_options(options),
+    m_queue(std::max<std::size_t>(options.queueSize, 1))
+{
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    if (m_thread) {
+        // the writer thread drains the queue before it stops
+        m_stop.store(true);
+        m_signal.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        }
+        m_wakeup.notify_one();
+        m_thread->wait();
+        delete m_thread;
+    }
+}
+
+/*!
+ * \brief Opens the first log file and starts the writer thread
+ */
+bool AsyncLogWriter::start()
+{
+    if (m_options.format == Format::Chunked) {
+        return startWriter<ChunkedLogWriter>();
+    }
+    return startWriter<LogFileWriter>();
+}
+
+template<typename Writer>
+bool AsyncLogWriter::startWriter()
+{
+    std::unique_ptr<Writer> writer(new Writer);
+    if (!openNextFile(*writer)) {
+        return false;
+    }
+    // the writer is only used by the writer thread from now on
+    m_thread = QThread::create([this, writer = writer.release()]() {
+        std::unique_ptr<Writer> threadWriter(writer);
+        run(*threadWriter);
+    });
+    m_thread->setObjectName("log writer");
+    m_thread->start();
+    m_statisticsTimer.start();
+    return true;
+}
+
+template<typename Writer>
+bool AsyncLogWriter::openNextFile(Writer &writer)
+{
+    QString filename = m_filename;
+    const qint64 index = m_files.load();
+    if (index > 0) {
+        const QFileInfo info(m_filename);
+        filename = info.path() + "/" + info.completeBaseName() + QString("-%1.").arg(index) + info.suffix();
+    }
+    if (!writer.open(filename)) {
+        m_errorMsg = "Could not open log file " + filename;
+        return false;
+    }
+    m_files.fetch_add(1);
+    m_currentFilename = filename;
+    return true;
+}
+
+void AsyncLogWriter::writeStatus(const Status &status)
+{
+    const quint64 head = m_head.load(std::memory_order_relaxed);
+    quint64 tail = m_tail.load(std::memory_order_acquire);
+    while (head - tail >= m_queue.size()) {
+        if (m_options.policy == OverflowPolicy::Drop || !m_thread) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_tail.wait(tail, std::memory_order_acquire);
+        tail = m_tail.load(std::memory_order_acquire);
+    }
+
+    m_queue[head % m_queue.size()] = status;
+    m_head.store(head + 1, std::memory_order_release);
+    m_signal.fetch_add(1, std::memory_order_seq_cst);
+    if (m_writerWaiting.load(std::memory_order_seq_cst)) {
+        // taking the mutex ensures the writer thread is either before its
+        // check of the signal or already waiting for the notification
+        {
+            std::lock_guard<std::mutex> lock(m_wakeupMutex);
+        }
+        m_wakeup.notify_one();
+    }
+}
+
+void AsyncLogWriter::waitForStatus(quint32 signal, int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(m_wakeupMutex);
+    m_writerWaiting.store(true, std::memory_order_seq_cst);
+    m_wakeup.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, signal]() {
+        return m_signal.load(std::memory_order_seq_cst) != signal;
+    });
+    m_writerWaiting.store(false, std::memory_order_relaxed);
+}
+
+template<typename Writer>
+void AsyncLogWriter::run(Writer &writer)
+{
+    QElapsedTimer fileAge;
+    fileAge.start();
+    qint64 fileBytes = 0;
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    bool unflushed = false;
+
+    while (true) {
+        if (unflushed && sinceFlush.elapsed() >= FLUSH_INTERVAL && !m_failed.load(std::memory_order_relaxed)) {
+            if (!flushWriter(writer, m_currentFilename)) {
+                failWriter(writer);
+                continue;
+            }
+            updateFileSize(fileBytes);
+            unflushed = false;
+            sinceFlush.restart();
+        }
+
+        const quint32 signal = m_signal.load(std::memory_order_seq_cst);
+        const quint64 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            if (m_stop.load()) {
+                break;
+            }
+            const int untilFlush = unflushed ? std::max<qint64>(FLUSH_INTERVAL - sinceFlush.elapsed(), 0) : FLUSH_INTERVAL;
+            waitForStatus(signal, untilFlush);
+            continue;
+        }
+
+        Status &slot = m_queue[tail % m_queue.size()];
+        const Status status = std::move(slot);
+        slot.reset();
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_tail.notify_one();
+
+        if (m_failed.load(std::memory_order_relaxed)) {
+            // keep draining the queue, so that a blocked producer can continue
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        const bool rotateBySize = m_options.rotateBytes > 0 && fileBytes >= m_options.rotateBytes;
+        const bool rotateByTime = m_options.rotateSeconds > 0 && fileAge.elapsed() >= m_options.rotateSeconds * 1000;
+        if (rotateBySize || rotateByTime) {
+            if (!closeWriter(writer)) {
+                failWriter(writer);
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            updateFileSize(fileBytes);
+            if (!openNextFile(writer)) {
+                qWarning("%s, stopping the recording", qPrintable(m_errorMsg));
+                m_failed.store(true);
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            fileAge.restart();
+            fileBytes = 0;
+        }
+
+        QElapsedTimer writeTime;
+        writeTime.start();
+        const bool written = writeToWriter(writer, status);
+        const qint64 duration = writeTime.nsecsElapsed();
+        if (!written) {
+            failWriter(writer);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        unflushed = true;
+
+        m_written.fetch_add(1, std::memory_order_relaxed);
+        m_writeTimeSum.fetch_add(duration, std::memory_order_relaxed);
+        m_writeCount.fetch_add(1, std::memory_order_relaxed);
+        qint64 maxWriteTime = m_maxWriteTime.load(std::memory_order_relaxed);
+        while (duration > maxWriteTime && !m_maxWriteTime.compare_exchange_weak(maxWriteTime, duration)) { }
+    }
+    if (!m_failed.load()) {
+        if (!closeWriter(writer)) {
+            failWriter(writer);
+        }
+        updateFileSize(fileBytes);
+    }
+}
+
+/*!
+ * \brief Adds the growth of the current log file to the written bytes
+ *
+ * Called after the log was flushed or closed, thus the size includes
+ * compression and the framing of the log format.
+ */
+void AsyncLogWriter::updateFileSize(qint64 &fileBytes)
+{
+    const qint64 size = QFileInfo(m_currentFilename).size();
+    if (size > fileBytes) {
+        m_writtenBytes.fetch_add(size - fileBytes, std::memory_order_relaxed);
+        fileBytes = size;
+    }
+}
+
+template<typename Writer>
+void AsyncLogWriter::failWriter(Writer &writer)
+{
+    m_errorMsg = writerError(writer);
+    if (m_errorMsg.isEmpty()) {
+        m_errorMsg = "Could not write log file " + m_currentFilename;
+    }
+    qWarning("%s, stopping the recording", qPrintable(m_errorMsg));
+    m_failed.store(true);
+}
+
+AsyncLogWriter::Statistics AsyncLogWriter::statistics()
+{
+    const qint64 writeCount = m_writeCount.exchange(0);
+    const qint64 writeTimeSum = m_writeTimeSum.exchange(0);
+    const qint64 writtenBytes = m_writtenBytes.exchange(0);
+    const qint64 elapsed = m_statisticsTimer.isValid() ? m_statisticsTimer.restart() : 0;
+    return {
+        qint64(m_head.load() - m_tail.load()),
+        m_written.load(),
+        elapsed > 0 ? writtenBytes * 1000.0 / elapsed : 0.0,
+        m_dropped.load(),
+        m_files.load(),
+        writeCount > 0 ? writeTimeSum / writeCount : 0,
+        m_maxWriteTime.exchange(0)
+    };
+}
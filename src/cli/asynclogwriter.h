@@ -0,0 +1,135 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef ASYNCLOGWRITER_H
+#define ASYNCLOGWRITER_H
+
+#include "protobuf/status.h"
+#include <QElapsedTimer>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class QThread;
+
+/*!
+ * \brief Records statuses to a log file using a dedicated writer thread
+ *
+ * The statuses are passed through a bounded lock-free queue with a single
+ * producer and a single consumer. If the queue is full, a status is either
+ * dropped or the producer blocks until the writer caught up. The producer
+ * never serializes or sizes a status. The writer thread forces the log to disk
+ * once per second. The log is rotated to a new file once it reached the
+ * configured size or age.
+ */
+class AsyncLogWriter
+{
+public:
+    enum class OverflowPolicy {
+        Drop,
+        Block
+    };
+
+    enum class Format {
+        //! the log format of ra and the autoref gui
+        Seshat,
+        //! compressed chunks with a time index, see ChunkedLogWriter
+        Chunked
+    };
+
+    struct Options {
+        Format format = Format::Seshat;
+        //! maximum number of statuses waiting to be written
+        std::size_t queueSize = 4096;
+        OverflowPolicy policy = OverflowPolicy::Drop;
+        //! file size in bytes after which a new file is started, 0 to disable
+        qint64 rotateBytes = 0;
+        //! seconds after which a new file is started, 0 to disable
+        qint64 rotateSeconds = 0;
+    };
+
+    struct Statistics {
+        qint64 queuedStatuses;
+        qint64 writtenStatuses;
+        //! growth of the log files per second since the last call
+        double writtenBytesPerSecond;
+        qint64 droppedStatuses;
+        qint64 files;
+        //! mean and maximum time to write one status since the last call, in nanoseconds
+        qint64 meanWriteTime;
+        qint64 maxWriteTime;
+    };
+
+public:
+    AsyncLogWriter(const QString &filename, const Options &options);
+    ~AsyncLogWriter();
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    bool start();
+    QString errorMsg() const { return m_errorMsg; }
+    //! must always be called from the same thread
+    void writeStatus(const Status &status);
+    Statistics statistics();
+
+private:
+    template<typename Writer> void run(Writer &writer);
+    template<typename Writer> bool openNextFile(Writer &writer);
+    template<typename Writer> bool startWriter();
+    void waitForStatus(quint32 signal, int timeoutMs);
+    template<typename Writer> void failWriter(Writer &writer);
+    void updateFileSize(qint64 &fileBytes);
+
+    const QString m_filename;
+    const Options m_options;
+    QString m_errorMsg;
+    QThread *m_thread = nullptr;
+    //! only used by the writer thread once it is started
+    QString m_currentFilename;
+
+    std::vector<Status> m_queue;
+    //! index of the next status to write, only advanced by the producer
+    std::atomic<quint64> m_head { 0 };
+    //! index of the next status to read, only advanced by the writer thread
+    std::atomic<quint64> m_tail { 0 };
+    //! changed on every push and on stop to wake up the writer thread
+    std::atomic<quint32> m_signal { 0 };
+    //! the producer only locks the mutex if the writer thread waits
+    std::atomic<bool> m_writerWaiting { false };
+    std::mutex m_wakeupMutex;
+    std::condition_variable m_wakeup;
+    std::atomic<bool> m_stop { false };
+    //! set by the writer thread if it could not open the next log file
+    std::atomic<bool> m_failed { false };
+
+    std::atomic<qint64> m_written { 0 };
+    std::atomic<qint64> m_writtenBytes { 0 };
+    QElapsedTimer m_statisticsTimer;
+    std::atomic<qint64> m_dropped { 0 };
+    std::atomic<qint64> m_files { 0 };
+    std::atomic<qint64> m_writeTimeSum { 0 };
+    std::atomic<qint64> m_writeCount { 0 };
+    std::atomic<qint64> m_maxWriteTime { 0 };
+};
+
+#endif // ASYNCLOGWRITER_H
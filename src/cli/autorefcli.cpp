@@ -21,17 +21,42 @@
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHostAddress>
 #include <QMetaObject>
 #include <QObject>
+#include <QSocketNotifier>
 #include <QString>
+#include <QStringList>
 #include <QTime>
+#include <QTimer>
 #include <QtGlobal>
+#include <algorithm>
+#include <csignal>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
+#ifdef Q_OS_UNIX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "amun/amun.h"
 #include "amun/amunclient.h"
+#include "amun/amunoptions.h"
+#include "amun/amunthreadpool.h"
+#include "amun/recordingfilter.h"
+#include "amun/ruleprofile.h"
 #include "core/sslprotocols.h"
 #include "protobuf/command.h"
 #include "protobuf/status.h"
-#include "seshat/logfilewriter.h"
+#include "asynclogwriter.h"
+#include "jsonlinesoutput.h"
+#include "metricsserver.h"
+#include "replaybenchmark.h"
 #include "testtools.h"
 
 #define TIMESTAMP (qPrintable(QTime::currentTime().toString()))
@@ -40,34 +65,316 @@ namespace {
 
 const QString DEFAULT_INIT_SCRIPT = AUTOREF_DIR "/autoref/init.lua";
 
+struct FieldPorts {
+    std::uint32_t m_visionPort;
+    std::uint32_t m_gameControllerPort;
+    std::uint32_t m_trackerPort;
+};
+
 struct Settings {
-    LogFileWriter m_logfile;
+    QString m_recordLog;
+    AsyncLogWriter::Options m_recordOptions;
+    std::unique_ptr<AsyncLogWriter> m_recorder;
+    RecordingFilter::Profile m_recordProfile = RecordingFilter::Profile::Full;
+    double m_recordDebugRate = 10;
+    std::unique_ptr<RecordingFilter> m_recordFilter;
     QString m_initScript = DEFAULT_INIT_SCRIPT;
     QString m_entryPoint;
     std::uint32_t m_visionPort = SSL_VISION_PORT;
     std::uint32_t m_gameControllerPort = SSL_GAME_CONTROLLER_PORT;
     std::uint32_t m_trackerPort = SSL_VISION_TRACKER_PORT;
+    //! multiple fields are run with a shared thread pool, the ports above are ignored then
+    std::vector<FieldPorts> m_fields;
+    int m_workerThreads = 0;
+    AmunOptions m_amunOptions;
+    int m_latencyInterval = 10;
+    QString m_replayLog;
+    double m_replayFrom = 0;
+    QString m_replayGameController;
+    bool m_benchmark = false;
+    bool m_reloadOnChange = false;
+    std::unique_ptr<JsonLinesOutput> m_jsonOutput;
+    QHostAddress m_metricsAddress = QHostAddress::LocalHost;
+    quint16 m_metricsPort = 0;
+};
+
+//! Periodically prints the latency and allocation summary published by amun
+class LatencyReporter {
+public:
+    explicit LatencyReporter(int intervalSeconds) : m_interval(intervalSeconds * 1000) {
+        m_timer.start();
+    }
+
+    void handleStatus(const Status &status) {
+        static const std::string PREFIX = "Latency [ms]/";
+        static const std::string ALLOCATIONS_PER_FRAME = "Allocations/per frame";
+        if (m_interval <= 0) {
+            return;
+        }
+
+        for (const auto &debug : status->debug()) {
+            if (debug.source() != amun::Controller) {
+                continue;
+            }
+            for (const auto &value : debug.value()) {
+                const std::string &key = value.key();
+                if (key == ALLOCATIONS_PER_FRAME) {
+                    m_allocationsPerFrame = value.float_value();
+                    continue;
+                }
+                const std::size_t split = key.rfind('/');
+                if (key.compare(0, PREFIX.size(), PREFIX) != 0 || split < PREFIX.size()) {
+                    continue;
+                }
+                Summary &summary = m_stages[key.substr(PREFIX.size(), split - PREFIX.size())];
+                const std::string quantity = key.substr(split + 1);
+                if (quantity == "p50") {
+                    summary.p50 = value.float_value();
+                } else if (quantity == "p99") {
+                    summary.p99 = value.float_value();
+                } else if (quantity == "max") {
+                    summary.max = value.float_value();
+                }
+            }
+        }
+
+        if (!m_stages.empty() && m_timer.hasExpired(m_interval)) {
+            for (const auto &[stage, summary] : m_stages) {
+                qInfo("%s Latency %s: p50 %.2f ms, p99 %.2f ms, max %.2f ms", TIMESTAMP, stage.c_str(),
+                      summary.p50, summary.p99, summary.max);
+            }
+            if (m_allocationsPerFrame >= 0) {
+                qInfo("%s Allocations per frame: %.1f", TIMESTAMP, m_allocationsPerFrame);
+            }
+            m_stages.clear();
+            m_timer.restart();
+        }
+    }
+
+private:
+    struct Summary {
+        float p50 = 0;
+        float p99 = 0;
+        float max = 0;
+    };
+
+    qint64 m_interval;
+    float m_allocationsPerFrame = -1;
+    QElapsedTimer m_timer;
+    std::map<std::string, Summary> m_stages;
+};
+
+//! Keeps the latest per rule profile of the autoref to print it on exit
+class RuleProfileSummary {
+public:
+    void handleStatus(const Status &status) {
+        updateRuleProfiles(status, m_profiles);
+    }
+
+    void print() const {
+        if (m_profiles.empty()) {
+            return;
+        }
+        std::vector<std::pair<std::string, RuleProfile>> profiles(m_profiles.begin(), m_profiles.end());
+        std::sort(profiles.begin(), profiles.end(), [](const auto &a, const auto &b) { return a.second.total > b.second.total; });
+
+        qInfo("Rule profile of every 10th frame:");
+        qInfo("%-36s %10s %12s %10s %10s %14s", "Rule", "Calls", "Total [ms]", "Mean [ms]", "Max [ms]", "Alloc [B/call]");
+        for (const auto &[name, profile] : profiles) {
+            const double calls = std::max<double>(profile.calls, 1.0);
+            qInfo("%-36s %10.0f %12.1f %10.3f %10.3f %14.0f", name.c_str(), profile.calls, profile.total,
+                  profile.total / calls, profile.max, profile.allocated / calls);
+        }
+    }
+
+private:
+    std::map<std::string, RuleProfile> m_profiles;
 };
 
+//! Counts the game events the autoref passed to the game controller connection in this status
+int countSentGameEvents(const Status &status) {
+    static const std::string PREFIX = "Sent game events/";
+    static const std::string TYPE_SUFFIX = "/type";
+
+    int count = 0;
+    for (const auto &debug : status->debug()) {
+        if (debug.source() != amun::Autoref) {
+            continue;
+        }
+        for (const auto &value : debug.value()) {
+            // every sent event has its own index
+            const std::string &key = value.key();
+            if (key.size() > PREFIX.size() + TYPE_SUFFIX.size() && key.compare(0, PREFIX.size(), PREFIX) == 0
+                    && key.compare(key.size() - TYPE_SUFFIX.size(), TYPE_SUFFIX.size(), TYPE_SUFFIX) == 0) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+void printRecorderStatistics(AsyncLogWriter &recorder) {
+    const AsyncLogWriter::Statistics stats = recorder.statistics();
+    qInfo("%s Recording: %lld written (%.1f kB/s), %lld dropped, %lld queued, %lld files, write time mean %.3f ms, max %.3f ms",
+          TIMESTAMP, stats.writtenStatuses, stats.writtenBytesPerSecond / 1000.0, stats.droppedStatuses, stats.queuedStatuses,
+          stats.files, stats.meanWriteTime * 1E-6, stats.maxWriteTime * 1E-6);
+}
+
+#ifdef Q_OS_UNIX
+int quitSignalFds[2];
+
+void handleQuitSignal(int) {
+    const char c = 1;
+    // only async signal safe functions may be used here
+    [[maybe_unused]] const ssize_t written = ::write(quitSignalFds[0], &c, sizeof(c));
+}
+#endif
+
+//! Quit the event loop on SIGINT and SIGTERM, so that the summaries can be printed
+void installQuitHandler(QCoreApplication &app) {
+#ifdef Q_OS_UNIX
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, quitSignalFds) != 0) {
+        qWarning("Could not create the socket pair for signal handling");
+        return;
+    }
+    QSocketNotifier *notifier = new QSocketNotifier(quitSignalFds[1], QSocketNotifier::Read, &app);
+    QObject::connect(notifier, &QSocketNotifier::activated, &app, &QCoreApplication::quit);
+
+    struct sigaction action = {};
+    action.sa_handler = handleQuitSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+#else
+    Q_UNUSED(app);
+#endif
+}
+
 void getSettings(Settings& settings) {
     QCommandLineParser parser;
     parser.setApplicationDescription("Command line interface for the ER-Force autoref");
     parser.addHelpOption();
 
     QCommandLineOption recordLogOption { "record", "Record the game to the specified log file", "logfile" };
+    QCommandLineOption recordFormatOption { "record-format", "Log format to record: seshat (default) or chunked, which is compressed and can be seeked quickly", "format" };
+    QCommandLineOption recordProfileOption { "record-profile", "Parts of the statuses to record: full (default), decisions for the game and world state "
+                                                               "and log messages, or debug:<Hz> to record the debug output at most at the given rate", "profile" };
+    QCommandLineOption recordPolicyOption { "record-policy", "What to do if the log file can't be written fast enough: drop (default) or block", "policy" };
+    QCommandLineOption recordQueueOption { "record-queue", "Maximum number of statuses waiting to be written to the log file (default 4096)", "statuses" };
+    QCommandLineOption recordRotateSizeOption { "record-rotate-size", "Continue the recording in a new log file after this many megabytes", "megabytes" };
+    QCommandLineOption recordRotateTimeOption { "record-rotate-time", "Continue the recording in a new log file after this many minutes", "minutes" };
     QCommandLineOption visionPortOption { "vision-port", "Port to receive vision detections on", "vision-port" };
     QCommandLineOption trackerPortOption { "tracker-port", "Port to publish tracking results on", "tracker-port" };
     QCommandLineOption gameControllerPortOption { "gc-port", "Port to receive game controller/referee messages on", "gc-port" };
+    QCommandLineOption latencyIntervalOption { "latency-interval", "Interval in seconds to print the latency summary in, 0 to disable (default 10)", "seconds" };
+    QCommandLineOption networkBackendOption { "network-backend", "Network backend to receive vision and referee packets with: qt (default) or batched (Linux only)", "backend" };
+    QCommandLineOption outputOption { "output", "Format of the autoref output on stdout: text (default) or jsonl with one record per log message, state switch and game event", "format" };
+    QCommandLineOption metricsOption { "metrics", "Serve metrics in the Prometheus text format on [address:]port, the address defaults to localhost", "[address:]port" };
+    QCommandLineOption fieldOption { "field", "Run an autoref for a field with the given vision, game controller and tracker ports, "
+                                              "e.g. 10006,10003,10010. Can be given multiple times to run several fields in one process", "ports" };
+    QCommandLineOption workerThreadsOption { "worker-threads", "Number of worker threads shared by the fields (default two per field, one for the processor and one for the autoref)", "threads" };
+    QCommandLineOption replayOption { "replay", "Run the autoref on a recorded log as fast as possible instead of receiving packets", "logfile" };
+    QCommandLineOption replayFromOption { "replay-from", "Start the replay this many seconds after the beginning of the log", "seconds" };
+    QCommandLineOption replayGameControllerOption { "replay-game-controller", "Send the game events of the replay to the game controller on this host "
+                                                                          "instead of passing them on internally", "host" };
+    QCommandLineOption benchmarkOption { "benchmark", "Print throughput, frame latency and cpu time after replaying and suppress the autoref output" };
+    QCommandLineOption latestWinsOption { "latest-wins", "Only pass the freshest world state to the autoref and the tracker publisher if they fall behind, instead of queueing every frame" };
+    QCommandLineOption reloadOnChangeOption { "reload-on-change", "Reload the autoref when one of its files changes. The reloaded autoref is warmed up "
+                                                              "on a background thread and replaces the running one without missing a frame" };
+    QCommandLineOption threadConfigOption { "thread-config", "Load cpu affinity and scheduling of the threads from an ini file (Linux only)", "file" };
+    QCommandLineOption threadOption { "thread", "Set cpu affinity and scheduling of a thread (processor, network, network-engine or autoref), "
+                                                "e.g. autoref:cpus=2-3:fifo=50:nice=-5. Can be given multiple times and overrides the thread config (Linux only)", "spec" };
+    QCommandLineOption isolatedCpusOption { "isolated-cpus", "Keep threads without explicit cpus off these cpus, e.g. 2-3 (Linux only)", "cpus" };
 
     parser.addOption(recordLogOption);
+    parser.addOption(recordFormatOption);
+    parser.addOption(recordProfileOption);
+    parser.addOption(recordPolicyOption);
+    parser.addOption(recordQueueOption);
+    parser.addOption(recordRotateSizeOption);
+    parser.addOption(recordRotateTimeOption);
     parser.addOption(visionPortOption);
     parser.addOption(trackerPortOption);
     parser.addOption(gameControllerPortOption);
+    parser.addOption(networkBackendOption);
+    parser.addOption(latencyIntervalOption);
+    parser.addOption(outputOption);
+    parser.addOption(metricsOption);
+    parser.addOption(fieldOption);
+    parser.addOption(workerThreadsOption);
+    parser.addOption(replayOption);
+    parser.addOption(replayFromOption);
+    parser.addOption(replayGameControllerOption);
+    parser.addOption(benchmarkOption);
+    parser.addOption(latestWinsOption);
+    parser.addOption(reloadOnChangeOption);
+    parser.addOption(threadConfigOption);
+    parser.addOption(threadOption);
+    parser.addOption(isolatedCpusOption);
 
     parser.process(*QCoreApplication::instance());
 
-    if (parser.isSet(recordLogOption)) {
-        settings.m_logfile.open(parser.value(recordLogOption));
+    settings.m_recordLog = parser.value(recordLogOption);
+
+    if (parser.isSet(recordFormatOption)) {
+        const QString format = parser.value(recordFormatOption);
+        if (format == "seshat") {
+            settings.m_recordOptions.format = AsyncLogWriter::Format::Seshat;
+        } else if (format == "chunked") {
+            settings.m_recordOptions.format = AsyncLogWriter::Format::Chunked;
+        } else {
+            qFatal("Invalid record format, must be seshat or chunked");
+            std::exit(1);
+        }
+    }
+
+    if (parser.isSet(recordProfileOption)
+            && !RecordingFilter::parse(parser.value(recordProfileOption), settings.m_recordProfile, settings.m_recordDebugRate)) {
+        qFatal("Invalid record profile, must be full, decisions or debug:<Hz>");
+        std::exit(1);
+    }
+
+    if (parser.isSet(recordPolicyOption)) {
+        const QString policy = parser.value(recordPolicyOption);
+        if (policy == "drop") {
+            settings.m_recordOptions.policy = AsyncLogWriter::OverflowPolicy::Drop;
+        } else if (policy == "block") {
+            settings.m_recordOptions.policy = AsyncLogWriter::OverflowPolicy::Block;
+        } else {
+            qFatal("Invalid record policy, must be drop or block");
+            std::exit(1);
+        }
+    }
+
+    if (parser.isSet(recordQueueOption)) {
+        bool ok = false;
+        const int size = parser.value(recordQueueOption).toInt(&ok);
+        if (!ok || size <= 0) {
+            qFatal("Invalid record queue size, must be positive");
+            std::exit(1);
+        }
+        settings.m_recordOptions.queueSize = size;
+    }
+
+    if (parser.isSet(recordRotateSizeOption)) {
+        bool ok = false;
+        const double megabytes = parser.value(recordRotateSizeOption).toDouble(&ok);
+        if (!ok || megabytes <= 0) {
+            qFatal("Invalid rotation size, must be positive");
+            std::exit(1);
+        }
+        settings.m_recordOptions.rotateBytes = megabytes * 1E6;
+    }
+
+    if (parser.isSet(recordRotateTimeOption)) {
+        bool ok = false;
+        const double minutes = parser.value(recordRotateTimeOption).toDouble(&ok);
+        if (!ok || minutes <= 0) {
+            qFatal("Invalid rotation time, must be positive");
+            std::exit(1);
+        }
+        settings.m_recordOptions.rotateSeconds = minutes * 60;
     }
 
     if (parser.isSet(visionPortOption)) {
@@ -96,25 +403,328 @@ void getSettings(Settings& settings) {
         }
         settings.m_gameControllerPort = port;
     }
+
+    if (parser.isSet(networkBackendOption)) {
+        const QString backend = parser.value(networkBackendOption);
+        if (backend == "qt") {
+            settings.m_amunOptions.networkBackend = AmunOptions::NetworkBackend::Qt;
+        } else if (backend == "batched") {
+#ifdef Q_OS_LINUX
+            settings.m_amunOptions.networkBackend = AmunOptions::NetworkBackend::Batched;
+#else
+            qFatal("The batched network backend is only available on Linux");
+            std::exit(1);
+#endif
+        } else {
+            qFatal("Invalid network backend, must be qt or batched");
+            std::exit(1);
+        }
+    }
+
+    if (parser.isSet(latencyIntervalOption)) {
+        bool ok = false;
+        const int interval = parser.value(latencyIntervalOption).toInt(&ok);
+        if (!ok || interval < 0) {
+            qFatal("Invalid latency interval, must not be negative");
+            std::exit(1);
+        }
+        settings.m_latencyInterval = interval;
+    }
+
+    settings.m_amunOptions.latestWinsDelivery = parser.isSet(latestWinsOption);
+    settings.m_reloadOnChange = parser.isSet(reloadOnChangeOption);
+    settings.m_amunOptions.backgroundReload = settings.m_reloadOnChange;
+
+    if (parser.isSet(outputOption)) {
+        const QString output = parser.value(outputOption);
+        if (output != "text" && output != "jsonl") {
+            qFatal("Invalid output format, must be text or jsonl");
+            std::exit(1);
+        }
+        if (output == "jsonl") {
+            settings.m_jsonOutput.reset(new JsonLinesOutput(stdout));
+        }
+    }
+
+    if (parser.isSet(metricsOption)) {
+        const QString value = parser.value(metricsOption);
+        const int split = value.lastIndexOf(':');
+        bool ok = false;
+        const int port = value.mid(split + 1).toInt(&ok);
+        if (!ok || port <= 0 || port > 65535 || (split >= 0 && !settings.m_metricsAddress.setAddress(value.left(split)))) {
+            qFatal("Invalid metrics address, must be [address:]port");
+            std::exit(1);
+        }
+        settings.m_metricsPort = port;
+    }
+
+    for (const QString &field : parser.values(fieldOption)) {
+        const QStringList ports = field.split(',');
+        std::vector<std::uint32_t> values;
+        for (const QString &port : ports) {
+            bool ok = false;
+            const int value = port.toInt(&ok);
+            if (!ok || value <= 0 || value > 65535) {
+                break;
+            }
+            values.push_back(value);
+        }
+        if (ports.size() != 3 || values.size() != 3) {
+            qFatal("Invalid field %s, must be <vision port>,<gc port>,<tracker port>", qPrintable(field));
+            std::exit(1);
+        }
+        settings.m_fields.push_back({ values[0], values[1], values[2] });
+    }
+    settings.m_workerThreads = 2 * settings.m_fields.size();
+    if (parser.isSet(workerThreadsOption)) {
+        bool ok = false;
+        settings.m_workerThreads = parser.value(workerThreadsOption).toInt(&ok);
+        if (!ok || settings.m_workerThreads <= 0) {
+            qFatal("Invalid number of worker threads, must be positive");
+            std::exit(1);
+        }
+    }
+    if (!settings.m_fields.empty() && (parser.isSet(recordLogOption) || parser.isSet(replayOption)
+            || settings.m_jsonOutput || parser.isSet(metricsOption) || settings.m_reloadOnChange)) {
+        qFatal("--field can't be combined with --record, --replay, --output jsonl, --metrics or --reload-on-change yet");
+        std::exit(1);
+    }
+
+    settings.m_replayLog = parser.value(replayOption);
+    settings.m_benchmark = parser.isSet(benchmarkOption);
+    if (parser.isSet(replayFromOption)) {
+        bool ok = false;
+        settings.m_replayFrom = parser.value(replayFromOption).toDouble(&ok);
+        if (!ok || settings.m_replayFrom < 0 || settings.m_replayLog.isEmpty()) {
+            qFatal("--replay-from requires --replay and a non-negative number of seconds");
+            std::exit(1);
+        }
+    }
+    settings.m_replayGameController = parser.value(replayGameControllerOption);
+    if (!settings.m_replayGameController.isEmpty() && settings.m_replayLog.isEmpty()) {
+        qFatal("--replay-game-controller requires --replay");
+        std::exit(1);
+    }
+    if (settings.m_benchmark && settings.m_replayLog.isEmpty()) {
+        qFatal("--benchmark requires --replay");
+        std::exit(1);
+    }
+
+    if (parser.isSet(threadConfigOption)) {
+        QString error;
+        if (!settings.m_amunOptions.loadThreadConfig(parser.value(threadConfigOption), error)) {
+            qFatal("Invalid thread config: %s", qPrintable(error));
+            std::exit(1);
+        }
+    }
+
+    for (const QString &spec : parser.values(threadOption)) {
+        const int split = spec.indexOf(':');
+        AmunOptions::ThreadOptions *options = settings.m_amunOptions.threadOptions(spec.left(split));
+        if (!options || !AmunOptions::parseThreadOptions(spec.mid(split + 1), *options)) {
+            qFatal("Invalid thread specification %s", qPrintable(spec));
+            std::exit(1);
+        }
+    }
+
+    if (parser.isSet(isolatedCpusOption)) {
+        if (!AmunOptions::parseCpuList(parser.value(isolatedCpusOption), settings.m_amunOptions.isolatedCpus)) {
+            qFatal("Invalid list of isolated cpus");
+            std::exit(1);
+        }
+    }
+}
+
+bool startRecording(Settings &settings) {
+    if (settings.m_recordLog.isEmpty()) {
+        return true;
+    }
+    settings.m_recordFilter.reset(new RecordingFilter(settings.m_recordProfile, settings.m_recordDebugRate));
+    settings.m_recorder.reset(new AsyncLogWriter(settings.m_recordLog, settings.m_recordOptions));
+    if (!settings.m_recorder->start()) {
+        qCritical("%s", qPrintable(settings.m_recorder->errorMsg()));
+        return false;
+    }
+    return true;
+}
+
+void writeStatus(Settings &settings, const Status &status) {
+    if (!settings.m_recorder) {
+        return;
+    }
+    // only the recorded parts are serialized by the writer thread
+    const Status recorded = settings.m_recordFilter->filter(status);
+    if (recorded) {
+        settings.m_recorder->writeStatus(recorded);
+    }
 }
 
-Command buildCommand(const Settings& settings) {
+Command buildCommand(const Settings& settings, const FieldPorts &ports) {
     Command command { new amun::Command };
 
     amun::CommandStrategy *strategy = command->mutable_strategy_autoref();
     strategy->set_enable_debug(true);
+    strategy->set_auto_reload(settings.m_reloadOnChange);
     auto *load = strategy->mutable_load();
     load->set_filename(settings.m_initScript.toStdString());
     load->set_entry_point(settings.m_entryPoint.toStdString());
 
     amun::CommandAmun *amun = command->mutable_amun();
-    amun->set_vision_port(settings.m_visionPort);
-    amun->set_referee_port(settings.m_gameControllerPort);
-    amun->set_tracker_port(settings.m_trackerPort);
+    amun->set_vision_port(ports.m_visionPort);
+    amun->set_referee_port(ports.m_gameControllerPort);
+    amun->set_tracker_port(ports.m_trackerPort);
 
     return command;
 }
 
+void printStatus(const Status &status, amun::GameState_State &currentGameState, const char *prefix = "") {
+    for (const auto &debug : status->debug()) {
+        for (const auto &entry : debug.log()) {
+            // most log messages are plain text, only formatted ones need to be stripped
+            if (entry.text().find('<') == std::string::npos) {
+                qInfo("%s %s%s", TIMESTAMP, prefix, entry.text().c_str());
+            } else {
+                QString text = TestTools::stripHTML(QString::fromStdString(entry.text()));
+                qInfo("%s %s%s", TIMESTAMP, prefix, qPrintable(text));
+            }
+        }
+    }
+
+    if (status->has_game_state() && currentGameState != status->game_state().state()) {
+        currentGameState = status->game_state().state();
+        qInfo("%s %sSwitched state to %s\n", TIMESTAMP, prefix, amun::GameState_State_Name(currentGameState).c_str());
+    }
+}
+
+void outputStatus(Settings &settings, const Status &status, amun::GameState_State &currentGameState) {
+    if (settings.m_jsonOutput) {
+        settings.m_jsonOutput->handleStatus(status);
+    } else {
+        printStatus(status, currentGameState);
+    }
+}
+
+//! Prints the cpu usage of the shared threads, each worker runs the fields assigned to it
+void printThreadUsage(AmunThreadPool &pool, int fieldCount) {
+    static const std::string PREFIX = "Threads/";
+    static const std::string CPU_SUFFIX = "/cpu [%]";
+    amun::DebugValues debug;
+    pool.addToDebugValues(&debug, QDateTime::currentMSecsSinceEpoch() * 1000000LL);
+    for (const auto &value : debug.value()) {
+        const std::string &key = value.key();
+        if (key.size() < PREFIX.size() + CPU_SUFFIX.size()
+                || key.compare(key.size() - CPU_SUFFIX.size(), CPU_SUFFIX.size(), CPU_SUFFIX) != 0) {
+            continue;
+        }
+        const std::string name = key.substr(PREFIX.size(), key.size() - PREFIX.size() - CPU_SUFFIX.size());
+        QStringList fields;
+        for (int field = 0; field < fieldCount; field++) {
+            if (name == pool.processorWorker(field)->objectName().toStdString()) {
+                fields.append(QString("%1 processor").arg(field + 1));
+            }
+            if (name == pool.strategyWorker(field)->objectName().toStdString()) {
+                fields.append(QString("%1 strategy").arg(field + 1));
+            }
+        }
+        if (fields.isEmpty()) {
+            qInfo("%s CPU %s: %.1f %%", TIMESTAMP, name.c_str(), value.float_value());
+        } else {
+            qInfo("%s CPU %s (field %s): %.1f %%", TIMESTAMP, name.c_str(), qPrintable(fields.join(", ")), value.float_value());
+        }
+    }
+}
+
+//! Runs an independent autoref per field, all of them share the threads of one pool
+int runFields(QCoreApplication &app, Settings &settings) {
+    const int fieldCount = settings.m_fields.size();
+    std::shared_ptr<AmunThreadPool> pool(new AmunThreadPool(settings.m_workerThreads, settings.m_amunOptions));
+    // each instance lives in its own thread like with AmunClient, these are stopped before the pool
+    std::vector<std::unique_ptr<QThread>> amunThreads;
+    std::vector<amun::GameState_State> gameStates(fieldCount, amun::GameState_State_Halt);
+    std::vector<QByteArray> prefixes;
+    for (int field = 0; field < fieldCount; field++) {
+        prefixes.push_back(QString("[field %1] ").arg(field + 1).toUtf8());
+    }
+
+    for (int field = 0; field < fieldCount; field++) {
+        AmunOptions options = settings.m_amunOptions;
+        options.threadPool = pool;
+        options.instance = field;
+
+        Amun *amun = new Amun(false, options);
+        QThread *amunThread = new QThread;
+        amunThread->setObjectName(QString("amun %1").arg(field + 1));
+        amunThreads.emplace_back(amunThread);
+        amun->moveToThread(amunThread);
+        QObject::connect(amunThread, &QThread::finished, amun, &QObject::deleteLater);
+        QObject::connect(amun, &Amun::sendStatus, &app, [field, &gameStates, &prefixes](const Status &status) {
+            printStatus(status, gameStates[field], prefixes[field].constData());
+        });
+        amunThread->start();
+        QMetaObject::invokeMethod(amun, [amun]() { amun->start(); });
+        QMetaObject::invokeMethod(amun, "handleCommand", Q_ARG(Command, buildCommand(settings, settings.m_fields[field])));
+    }
+
+    QTimer usageTimer;
+    if (settings.m_latencyInterval > 0) {
+        QObject::connect(&usageTimer, &QTimer::timeout, [&pool, fieldCount]() {
+            printThreadUsage(*pool, fieldCount);
+        });
+        // the first sample only initializes the counters
+        printThreadUsage(*pool, fieldCount);
+        usageTimer.start(settings.m_latencyInterval * 1000);
+    }
+
+    installQuitHandler(app);
+    const int result = app.exec();
+    for (const auto &amunThread : amunThreads) {
+        amunThread->quit();
+    }
+    for (const auto &amunThread : amunThreads) {
+        amunThread->wait();
+    }
+    amunThreads.clear();
+    return result;
+}
+
+int runReplay(Settings &settings, const Command &command) {
+    ReplayBenchmark replay { command, settings.m_replayGameController };
+    amun::GameState_State currentGameState = amun::GameState_State_Halt;
+    RuleProfileSummary ruleProfile;
+    QObject::connect(&replay, &ReplayBenchmark::gotStatus, [&ruleProfile](const Status &status) {
+        ruleProfile.handleStatus(status);
+    });
+    int sentGameEvents = 0;
+    if (!settings.m_replayGameController.isEmpty()) {
+        QObject::connect(&replay, &ReplayBenchmark::gotStatus, [&sentGameEvents](const Status &status) {
+            sentGameEvents += countSentGameEvents(status);
+        });
+    }
+    if (!settings.m_benchmark) {
+        QObject::connect(&replay, &ReplayBenchmark::gotStatus, [&settings, &currentGameState](const Status &status) {
+            writeStatus(settings, status);
+            outputStatus(settings, status, currentGameState);
+        });
+    }
+
+    if (!replay.run(settings.m_replayLog, settings.m_replayFrom)) {
+        qCritical("%s", qPrintable(replay.errorMsg()));
+        return 1;
+    }
+    if (!settings.m_replayGameController.isEmpty()) {
+        // compared with the messages received by cmake/mock_game_controller.py, do not change
+        qInfo("Sent %d game events to the game controller", sentGameEvents);
+    }
+    if (settings.m_benchmark) {
+        replay.printSummary();
+    }
+    ruleProfile.print();
+    if (settings.m_recorder) {
+        printRecorderStatistics(*settings.m_recorder);
+    }
+    return 0;
+}
+
 }
 
 int main(int argc, char* argv[]) {
@@ -124,31 +734,59 @@ int main(int argc, char* argv[]) {
 
     Settings settings;
     getSettings(settings);
-    Command command = buildCommand(settings);
+    if (!settings.m_fields.empty()) {
+        return runFields(app, settings);
+    }
+
+    Command command = buildCommand(settings, { settings.m_visionPort, settings.m_gameControllerPort, settings.m_trackerPort });
+    if (!startRecording(settings)) {
+        return 1;
+    }
 
+    if (!settings.m_replayLog.isEmpty()) {
+        return runReplay(settings, command);
+    }
+
+    AmunOptions::setDefault(settings.m_amunOptions);
     AmunClient amun;
     amun.start();
 
     amun::GameState_State currentGameState = amun::GameState_State_Halt;
+    LatencyReporter latencyReporter { settings.m_latencyInterval };
+    RuleProfileSummary ruleProfile;
 
-    QObject::connect(&amun, &AmunClient::gotStatus, [&settings, &currentGameState](const Status &status) {
-        settings.m_logfile.writeStatus(status);
-
-        for (const auto &debug : status->debug()) {
-            for (const auto &entry : debug.log()) {
-                QString text = TestTools::stripHTML(QString::fromStdString(entry.text()));
-                qInfo("%s %s", TIMESTAMP, qPrintable(text));
-            }
+    MetricsServer metrics;
+    if (settings.m_metricsPort != 0) {
+        if (!metrics.listen(settings.m_metricsAddress, settings.m_metricsPort)) {
+            qCritical("Could not serve metrics: %s", qPrintable(metrics.errorMsg()));
+            return 1;
         }
+        QObject::connect(&amun, &AmunClient::gotStatus, &metrics, &MetricsServer::handleStatus);
+    }
 
-        if (status->has_game_state() && currentGameState != status->game_state().state()) {
-            currentGameState = status->game_state().state();
-            qInfo("%s Switched state to %s\n", TIMESTAMP, amun::GameState_State_Name(currentGameState).c_str());
-        }
+    QObject::connect(&amun, &AmunClient::gotStatus, [&settings, &currentGameState, &latencyReporter, &ruleProfile](const Status &status) {
+        writeStatus(settings, status);
+        latencyReporter.handleStatus(status);
+        ruleProfile.handleStatus(status);
+        outputStatus(settings, status, currentGameState);
     });
 
     QMetaObject::invokeMethod(&amun, "sendCommand", Q_ARG(Command, command));
 
-    return app.exec();
+    QTimer recorderTimer;
+    if (settings.m_recorder && settings.m_latencyInterval > 0) {
+        QObject::connect(&recorderTimer, &QTimer::timeout, [&settings]() {
+            printRecorderStatistics(*settings.m_recorder);
+        });
+        recorderTimer.start(settings.m_latencyInterval * 1000);
+    }
+
+    installQuitHandler(app);
+    const int result = app.exec();
+    ruleProfile.print();
+    if (settings.m_recorder) {
+        printRecorderStatistics(*settings.m_recorder);
+    }
+    return result;
 }
 
@@ -0,0 +1,180 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "jsonlinesoutput.h"
+#include "testtools.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+
+static const std::string GAME_EVENTS_PREFIX = "Sent game events/";
+// the buffer is written at least this often, in milliseconds
+static const int FLUSH_INTERVAL = 100;
+
+static void appendJsonString(std::string &out, const std::string &text)
+{
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[7];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+JsonLinesOutput::JsonLinesOutput(FILE *output) :
+    m_output(output)
+{
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("jsonl output");
+    m_thread->start();
+}
+
+JsonLinesOutput::~JsonLinesOutput()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.wakeOne();
+    m_thread->wait();
+    delete m_thread;
+}
+
+void JsonLinesOutput::beginRecord(const char *type, qint64 time)
+{
+    m_record.clear();
+    m_record += "{\"type\":\"";
+    m_record += type;
+    m_record += "\",\"time\":";
+    m_record += std::to_string(time);
+    m_record += ",\"frame_time\":";
+    m_record += std::to_string(m_frameTime);
+}
+
+void JsonLinesOutput::endRecord()
+{
+    m_record += "}\n";
+    QMutexLocker locker(&m_mutex);
+    m_buffer += m_record;
+}
+
+void JsonLinesOutput::handleStatus(const Status &status)
+{
+    if (status->has_world_state()) {
+        m_frameTime = status->world_state().time();
+    }
+
+    for (const auto &debug : status->debug()) {
+        const std::string &source = amun::DebugSource_Name(debug.source());
+        for (const auto &entry : debug.log()) {
+            beginRecord("log", status->time());
+            m_record += ",\"source\":";
+            appendJsonString(m_record, source);
+            m_record += ",\"text\":";
+            // most log messages are plain text, only formatted ones need to be stripped
+            if (entry.text().find('<') == std::string::npos) {
+                appendJsonString(m_record, entry.text());
+            } else {
+                appendJsonString(m_record, TestTools::stripHTML(QString::fromStdString(entry.text())).toStdString());
+            }
+            endRecord();
+        }
+
+        // each sent event is published as <index>/type and <index>/message
+        m_gameEvents.clear();
+        for (const auto &value : debug.value()) {
+            const std::string &key = value.key();
+            if (key.compare(0, GAME_EVENTS_PREFIX.size(), GAME_EVENTS_PREFIX) != 0) {
+                continue;
+            }
+            const std::size_t separator = key.find('/', GAME_EVENTS_PREFIX.size());
+            if (separator == std::string::npos) {
+                continue;
+            }
+            const std::string index = key.substr(GAME_EVENTS_PREFIX.size(), separator - GAME_EVENTS_PREFIX.size());
+            auto event = std::find_if(m_gameEvents.begin(), m_gameEvents.end(), [&index](const GameEvent &event) {
+                return event.index == index;
+            });
+            if (event == m_gameEvents.end()) {
+                m_gameEvents.push_back({ index, std::string(), std::string() });
+                event = m_gameEvents.end() - 1;
+            }
+            const std::string field = key.substr(separator + 1);
+            if (field == "type") {
+                event->type = value.string_value();
+            } else if (field == "message") {
+                event->message = value.string_value();
+            }
+        }
+        for (const GameEvent &event : m_gameEvents) {
+            beginRecord("game_event", status->time());
+            m_record += ",\"event\":";
+            appendJsonString(m_record, event.type);
+            m_record += ",\"message\":";
+            appendJsonString(m_record, event.message);
+            endRecord();
+        }
+    }
+
+    if (status->has_game_state() && m_gameState != status->game_state().state()) {
+        m_gameState = status->game_state().state();
+        beginRecord("state", status->time());
+        m_record += ",\"state\":";
+        appendJsonString(m_record, amun::GameState_State_Name(status->game_state().state()));
+        endRecord();
+    }
+}
+
+void JsonLinesOutput::run()
+{
+    std::string writing;
+    while (true) {
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_buffer.empty() && !m_stop) {
+                m_wakeup.wait(&m_mutex, FLUSH_INTERVAL);
+            }
+            // keeps the capacity of both buffers
+            writing.swap(m_buffer);
+        }
+        if (!writing.empty()) {
+            std::fwrite(writing.data(), 1, writing.size(), m_output);
+            std::fflush(m_output);
+            writing.clear();
+        }
+        QMutexLocker locker(&m_mutex);
+        if (m_stop && m_buffer.empty()) {
+            break;
+        }
+    }
+}
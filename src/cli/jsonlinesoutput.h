@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef JSONLINESOUTPUT_H
+#define JSONLINESOUTPUT_H
+
+#include "protobuf/status.h"
+#include <QMutex>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class QThread;
+
+/*!
+ * \brief Prints the autoref output as one JSON object per line
+ *
+ * Log messages, game state switches and sent game events are emitted as
+ * records with the status time and the time of the last vision frame. The
+ * records are collected in a buffer which is written by a separate thread,
+ * so handling a status never waits for the output.
+ */
+class JsonLinesOutput
+{
+public:
+    explicit JsonLinesOutput(FILE *output);
+    ~JsonLinesOutput();
+    JsonLinesOutput(const JsonLinesOutput&) = delete;
+    JsonLinesOutput& operator=(const JsonLinesOutput&) = delete;
+
+    void handleStatus(const Status &status);
+
+private:
+    struct GameEvent {
+        std::string index;
+        std::string type;
+        std::string message;
+    };
+
+private:
+    void beginRecord(const char *type, qint64 time);
+    void endRecord();
+    void run();
+
+    FILE *m_output;
+    QThread *m_thread;
+    qint64 m_frameTime = 0;
+    int m_gameState = -1;
+    //! record being built, only used by the thread calling handleStatus
+    std::string m_record;
+    //! sent game events of the current debug values, keeps its capacity
+    std::vector<GameEvent> m_gameEvents;
+
+    QMutex m_mutex;
+    QWaitCondition m_wakeup;
+    std::string m_buffer;
+    bool m_stop = false;
+};
+
+#endif // JSONLINESOUTPUT_H
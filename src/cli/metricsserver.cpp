@@ -0,0 +1,275 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "metricsserver.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <cstdio>
+#include <memory>
+
+static const std::string STATUS_BUS_PREFIX = "Status bus/";
+static const std::string QUEUE_DEPTH_SUFFIX = "/queue depth";
+static const std::string GAME_EVENTS_PREFIX = "Sent game events/";
+static const std::string GAME_EVENT_TYPE_SUFFIX = "/type";
+static const std::string FRAME_TIME_KEY = "Frame budget/frame time";
+static const std::string GAME_CONTROLLER_KEY = "Game controller/connected";
+static const std::string GAME_CONTROLLER_QUEUE_KEY = "Game controller/queue depth";
+static const std::string GAME_CONTROLLER_RECONNECTS_KEY = "Game controller/reconnects";
+static const std::string GAME_CONTROLLER_DROPPED_KEY = "Game controller/dropped events";
+static const std::string GAME_CONTROLLER_SENT_KEY = "Game controller/sent events";
+static const std::string GAME_CONTROLLER_LATENCY_KEY = "Game controller/queue latency/mean";
+
+static bool startsWith(const std::string &text, const std::string &prefix)
+{
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+static bool endsWith(const std::string &text, const std::string &suffix)
+{
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// label values must escape backslashes, quotes and newlines
+static std::string escapeLabel(const std::string &value)
+{
+    std::string escaped;
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+static void appendMetric(std::string &out, const char *name, const std::string &labels, double value)
+{
+    char number[32];
+    std::snprintf(number, sizeof(number), "%.17g", value);
+    out += name;
+    if (!labels.empty()) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    out += number;
+    out += '\n';
+}
+
+static void appendHeader(std::string &out, const char *name, const char *type, const char *help)
+{
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+MetricsServer::MetricsServer(QObject *parent) :
+    QObject(parent),
+    m_server(new QTcpServer(this)),
+    m_rateTimer(new QTimer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &MetricsServer::handleConnection);
+    connect(m_rateTimer, &QTimer::timeout, this, &MetricsServer::updateRates);
+}
+
+MetricsServer::~MetricsServer() = default;
+
+bool MetricsServer::listen(const QHostAddress &address, quint16 port)
+{
+    if (!m_server->listen(address, port)) {
+        return false;
+    }
+    m_rateInterval.start();
+    m_rateTimer->start(1000);
+    return true;
+}
+
+QString MetricsServer::errorMsg() const
+{
+    return m_server->errorString();
+}
+
+void MetricsServer::handleStatus(const Status &status)
+{
+    quint64 sentEvents = 0;
+    double meanQueueLatency = 0;
+    if (status->has_world_state()) {
+        m_trackerFrames++;
+        for (const auto &frame : status->world_state().vision_frames()) {
+            if (frame.has_detection()) {
+                m_visionPackets[frame.detection().camera_id()]++;
+            }
+        }
+    }
+
+    for (const auto &debug : status->debug()) {
+        for (const auto &value : debug.value()) {
+            const std::string &key = value.key();
+            if (debug.source() == amun::Controller) {
+                if (startsWith(key, STATUS_BUS_PREFIX) && endsWith(key, QUEUE_DEPTH_SUFFIX)) {
+                    const std::string name = key.substr(STATUS_BUS_PREFIX.size(),
+                                                        key.size() - STATUS_BUS_PREFIX.size() - QUEUE_DEPTH_SUFFIX.size());
+                    m_queueDepths[name] = value.float_value();
+                }
+            } else if (debug.source() == amun::Autoref) {
+                if (key == FRAME_TIME_KEY) {
+                    const double frameTime = value.float_value();
+                    for (std::size_t i = 0; i < FRAME_TIME_BUCKETS.size(); i++) {
+                        if (frameTime <= FRAME_TIME_BUCKETS[i]) {
+                            m_frameTimeBuckets[i]++;
+                        }
+                    }
+                    m_frameTimeCount++;
+                    m_frameTimeSum += frameTime;
+                } else if (startsWith(key, GAME_EVENTS_PREFIX)) {
+                    // every sent event has its own index, with the type as value
+                    if (endsWith(key, GAME_EVENT_TYPE_SUFFIX)) {
+                        m_gameEvents[value.string_value()]++;
+                    }
+                } else if (key == GAME_CONTROLLER_KEY) {
+                    m_gameControllerConnected = value.bool_value() ? 1 : 0;
+                } else if (key == GAME_CONTROLLER_QUEUE_KEY) {
+                    m_gameControllerQueueDepth = value.float_value();
+                } else if (key == GAME_CONTROLLER_RECONNECTS_KEY) {
+                    m_gameControllerReconnects = value.float_value();
+                } else if (key == GAME_CONTROLLER_DROPPED_KEY) {
+                    m_gameControllerDropped = value.float_value();
+                } else if (key == GAME_CONTROLLER_SENT_KEY) {
+                    sentEvents = value.float_value();
+                } else if (key == GAME_CONTROLLER_LATENCY_KEY) {
+                    meanQueueLatency = value.float_value();
+                }
+            }
+        }
+    }
+    // the mean is only meaningful together with the number of events of the same frame
+    m_queueLatencyCount += sentEvents;
+    m_queueLatencySum += sentEvents * meanQueueLatency;
+}
+
+void MetricsServer::updateRates()
+{
+    const double seconds = m_rateInterval.restart() * 1E-3;
+    if (seconds <= 0) {
+        return;
+    }
+    for (const auto &[camera, packets] : m_visionPackets) {
+        m_visionPacketRates[camera] = (packets - m_visionPacketsAtRate[camera]) / seconds;
+    }
+    m_visionPacketsAtRate = m_visionPackets;
+    m_trackerFrameRate = (m_trackerFrames - m_trackerFramesAtRate) / seconds;
+    m_trackerFramesAtRate = m_trackerFrames;
+}
+
+void MetricsServer::handleConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        // answer once the request header is complete, its contents do not matter
+        auto request = std::make_shared<QByteArray>();
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket, request]() {
+            request->append(socket->readAll());
+            if (request->contains("\r\n\r\n")) {
+                request->clear();
+                respond(socket);
+            } else if (request->size() > 16 * 1024) {
+                socket->abort();
+            }
+        });
+    }
+}
+
+void MetricsServer::respond(QTcpSocket *socket)
+{
+    const std::string body = formatMetrics();
+    const QByteArray header = QString("HTTP/1.0 200 OK\r\n"
+                                      "Content-Type: text/plain; version=0.0.4\r\n"
+                                      "Content-Length: %1\r\n"
+                                      "Connection: close\r\n\r\n").arg(body.size()).toUtf8();
+    socket->write(header);
+    socket->write(body.data(), body.size());
+    socket->disconnectFromHost();
+}
+
+std::string MetricsServer::formatMetrics() const
+{
+    std::string out;
+
+    appendHeader(out, "autoref_vision_packets_total", "counter", "Received vision detection packets");
+    for (const auto &[camera, packets] : m_visionPackets) {
+        appendMetric(out, "autoref_vision_packets_total", "camera=\"" + std::to_string(camera) + "\"", packets);
+    }
+    appendHeader(out, "autoref_vision_packet_rate", "gauge", "Received vision detection packets per second");
+    for (const auto &[camera, rate] : m_visionPacketRates) {
+        appendMetric(out, "autoref_vision_packet_rate", "camera=\"" + std::to_string(camera) + "\"", rate);
+    }
+
+    appendHeader(out, "autoref_tracker_frames_total", "counter", "World states created by the tracker");
+    appendMetric(out, "autoref_tracker_frames_total", "", m_trackerFrames);
+    appendHeader(out, "autoref_tracker_frame_rate", "gauge", "World states created by the tracker per second");
+    appendMetric(out, "autoref_tracker_frame_rate", "", m_trackerFrameRate);
+
+    appendHeader(out, "autoref_lua_frame_seconds", "histogram", "Run time of the autoref script per frame");
+    for (std::size_t i = 0; i < FRAME_TIME_BUCKETS.size(); i++) {
+        char bound[32];
+        std::snprintf(bound, sizeof(bound), "le=\"%g\"", FRAME_TIME_BUCKETS[i]);
+        appendMetric(out, "autoref_lua_frame_seconds_bucket", bound, m_frameTimeBuckets[i]);
+    }
+    appendMetric(out, "autoref_lua_frame_seconds_bucket", "le=\"+Inf\"", m_frameTimeCount);
+    appendMetric(out, "autoref_lua_frame_seconds_sum", "", m_frameTimeSum);
+    appendMetric(out, "autoref_lua_frame_seconds_count", "", m_frameTimeCount);
+
+    appendHeader(out, "autoref_queue_depth", "gauge", "Statuses waiting for delivery to a subscriber");
+    for (const auto &[name, depth] : m_queueDepths) {
+        appendMetric(out, "autoref_queue_depth", "subscriber=\"" + escapeLabel(name) + "\"", depth);
+    }
+
+    appendHeader(out, "autoref_game_events_total", "counter", "Game events sent to the game controller");
+    for (const auto &[type, count] : m_gameEvents) {
+        appendMetric(out, "autoref_game_events_total", "type=\"" + escapeLabel(type) + "\"", count);
+    }
+
+    if (m_gameControllerConnected >= 0) {
+        appendHeader(out, "autoref_game_controller_connected", "gauge", "Whether the autoref is connected to the game controller");
+        appendMetric(out, "autoref_game_controller_connected", "", m_gameControllerConnected);
+        appendHeader(out, "autoref_game_controller_queue_depth", "gauge", "Game events waiting to be sent to the game controller");
+        appendMetric(out, "autoref_game_controller_queue_depth", "", m_gameControllerQueueDepth);
+        appendHeader(out, "autoref_game_controller_reconnects_total", "counter", "Connections to the game controller after a lost connection");
+        appendMetric(out, "autoref_game_controller_reconnects_total", "", m_gameControllerReconnects);
+        appendHeader(out, "autoref_game_controller_dropped_events_total", "counter", "Game events dropped as the queue was full or they became outdated");
+        appendMetric(out, "autoref_game_controller_dropped_events_total", "", m_gameControllerDropped);
+        appendHeader(out, "autoref_game_controller_queue_latency_seconds", "summary", "Time from queueing a game event until it is passed to the game controller connection");
+        appendMetric(out, "autoref_game_controller_queue_latency_seconds_sum", "", m_queueLatencySum);
+        appendMetric(out, "autoref_game_controller_queue_latency_seconds_count", "", m_queueLatencyCount);
+    }
+    return out;
+}
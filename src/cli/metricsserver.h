@@ -0,0 +1,95 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include "protobuf/status.h"
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QObject>
+#include <QString>
+#include <array>
+#include <map>
+#include <string>
+
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+
+/*!
+ * \brief Serves metrics of the autoref in the Prometheus text format
+ *
+ * Handling a status only updates counters, the text is formatted when the
+ * metrics are requested. Any HTTP request is answered with all metrics.
+ */
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsServer(QObject *parent = nullptr);
+    ~MetricsServer() override;
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    bool listen(const QHostAddress &address, quint16 port);
+    QString errorMsg() const;
+
+public slots:
+    void handleStatus(const Status &status);
+
+private slots:
+    void handleConnection();
+    void updateRates();
+
+private:
+    void respond(QTcpSocket *socket);
+    std::string formatMetrics() const;
+
+    //! upper bounds of the frame time histogram in seconds
+    static constexpr std::array<double, 9> FRAME_TIME_BUCKETS = { 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5 };
+
+    QTcpServer *m_server;
+    QTimer *m_rateTimer;
+    QElapsedTimer m_rateInterval;
+
+    std::map<quint32, quint64> m_visionPackets;
+    std::map<quint32, quint64> m_visionPacketsAtRate;
+    std::map<quint32, double> m_visionPacketRates;
+    quint64 m_trackerFrames = 0;
+    quint64 m_trackerFramesAtRate = 0;
+    double m_trackerFrameRate = 0;
+
+    std::array<quint64, FRAME_TIME_BUCKETS.size()> m_frameTimeBuckets = {};
+    quint64 m_frameTimeCount = 0;
+    double m_frameTimeSum = 0;
+
+    std::map<std::string, float> m_queueDepths;
+    std::map<std::string, quint64> m_gameEvents;
+    int m_gameControllerConnected = -1;
+    quint64 m_gameControllerQueueDepth = 0;
+    quint64 m_gameControllerReconnects = 0;
+    quint64 m_gameControllerDropped = 0;
+    quint64 m_queueLatencyCount = 0;
+    double m_queueLatencySum = 0;
+};
+
+#endif // METRICSSERVER_H
@@ -0,0 +1,216 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "replaybenchmark.h"
+#include "amun/chunkedlogreader.h"
+#include "gamecontroller/strategygamecontrollermediator.h"
+#include "processor/processor.h"
+#include "protobuf/world.pb.h"
+#include "seshat/seqlogfilereader.h"
+#include "strategy/strategy.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMetaType>
+#include <algorithm>
+#include <ctime>
+
+// cpu time of the calling thread in nanoseconds
+static qint64 threadCpuTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+#else
+    return std::clock() * (1000000000LL / CLOCKS_PER_SEC);
+#endif
+}
+
+ReplayBenchmark::ReplayBenchmark(const Command &loadCommand, const QString &gameControllerHost, QObject *parent) :
+    QObject(parent),
+    m_gameControllerConnection(new StrategyGameControllerMediator(true))
+{
+    qRegisterMetaType<Command>("Command");
+    qRegisterMetaType<Status>("Status");
+
+    // events are passed on internally unless a game controller should receive them
+    if (gameControllerHost.isEmpty()) {
+        m_gameControllerConnection->switchInternalGameController(true);
+    } else {
+        m_gameControllerConnection->switchInternalGameController(false);
+        m_gameControllerConnection->handleExternalRefereeHost(gameControllerHost);
+    }
+    m_strategy = new Strategy(&m_timer, StrategyType::AUTOREF, nullptr, nullptr, m_gameControllerConnection, false);
+    connect(m_strategy, &Strategy::sendStatus, this, &ReplayBenchmark::gotStatus);
+    m_strategy->handleCommand(loadCommand);
+
+    m_processor = new Processor(&m_timer, false);
+    connect(m_processor, &Processor::sendStatus, this, &ReplayBenchmark::gotStatus);
+    connect(m_processor, &Processor::sendStrategyStatus, this, &ReplayBenchmark::handleTrackedStatus);
+}
+
+ReplayBenchmark::~ReplayBenchmark()
+{
+    delete m_processor;
+    delete m_strategy;
+}
+
+/*!
+ * \brief Passes every status of the log to the strategy
+ *
+ * Each world state is one frame, its latency is the time until the strategy
+ * has processed it. Chunked logs seek directly to the first replayed status,
+ * the statuses skipped in other logs still have to be read.
+ */
+bool ReplayBenchmark::run(const QString &filename, double skipSeconds)
+{
+    const qint64 skip = skipSeconds * 1E9;
+    if (ChunkedLogReader::isChunkedLog(filename)) {
+        ChunkedLogReader logfile;
+        if (!logfile.open(filename)) {
+            m_errorMsg = logfile.errorMsg();
+            return false;
+        }
+        if (skip > 0 && !logfile.seek(logfile.startTime() + skip)) {
+            m_errorMsg = logfile.errorMsg();
+            return false;
+        }
+        return replay(logfile, 0);
+    }
+
+    SeqLogFileReader logfile;
+    if (!logfile.open(filename)) {
+        m_errorMsg = "Could not open log file " + filename;
+        return false;
+    }
+    return replay(logfile, skip);
+}
+
+template<typename Reader>
+bool ReplayBenchmark::replay(Reader &logfile, qint64 skip)
+{
+    qint64 skipUntil = 0;
+    QElapsedTimer wallTime;
+    wallTime.start();
+    while (!logfile.atEnd()) {
+        const qint64 readStart = threadCpuTime();
+        const Status status = logfile.readStatus();
+        if (!status) {
+            m_errorMsg = "Failed to read status " + QString::number(m_statusCount);
+            return false;
+        }
+        const qint64 readEnd = threadCpuTime();
+        m_readCpuTime += readEnd - readStart;
+        if (skip > 0) {
+            if (skipUntil == 0) {
+                skipUntil = status->time() + skip;
+            }
+            if (status->time() < skipUntil) {
+                continue;
+            }
+        }
+        m_statusCount++;
+
+        if (status->has_game_state()) {
+            m_gameState.CopyFrom(status->game_state());
+            m_hasGameState = true;
+        }
+        if (m_retrack < 0 && status->has_world_state()) {
+            m_retrack = status->world_state().vision_frames_size() > 0;
+            if (!m_retrack) {
+                qWarning("The log contains no vision packets, replaying the recorded world states without tracking");
+            }
+        }
+
+        const qint64 frameStart = wallTime.nsecsElapsed();
+        // the time jumps to the recorded status time, it runs at normal
+        // speed during a frame to allow measuring durations in lua
+        m_timer.setTime(status->time(), 1);
+        qint64 strategyStart = readEnd;
+        if (m_retrack > 0) {
+            if (status->has_world_state()) {
+                track(status);
+                strategyStart = threadCpuTime();
+                m_trackingCpuTime += strategyStart - readEnd;
+            }
+        } else {
+            m_strategy->handleStatus(status);
+        }
+        // the strategy is run by events posted to this thread
+        QCoreApplication::processEvents();
+        m_strategyCpuTime += threadCpuTime() - strategyStart;
+        if (status->has_world_state()) {
+            m_frameTimes.push_back(wallTime.nsecsElapsed() - frameStart);
+        }
+    }
+    m_wallTime = wallTime.nsecsElapsed();
+    return true;
+}
+
+/*!
+ * \brief Passes the vision packets of a recorded world state to the processor and runs the tracking
+ *
+ * The receive times of the packets are not recorded, they are stamped with
+ * the time of the world state they were used in.
+ */
+void ReplayBenchmark::track(const Status &status)
+{
+    const world::State &worldState = status->world_state();
+    m_timer.setTime(worldState.time(), 1);
+    for (const SSL_WrapperPacket &frame : worldState.vision_frames()) {
+        QByteArray data;
+        data.resize(frame.ByteSizeLong());
+        if (frame.SerializeToArray(data.data(), data.size())) {
+            m_processor->handleVisionPacket(data, worldState.time(), "replay");
+        }
+    }
+    // otherwise run by a timer of the processor
+    QMetaObject::invokeMethod(m_processor, "process", Qt::DirectConnection);
+}
+
+void ReplayBenchmark::handleTrackedStatus(const Status &status)
+{
+    if (m_hasGameState) {
+        status->mutable_game_state()->CopyFrom(m_gameState);
+    }
+    m_strategy->handleStatus(status);
+}
+
+static double percentile(std::vector<qint64> &samples, double fraction)
+{
+    const std::size_t index = std::min<std::size_t>(samples.size() * fraction, samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index] * 1E-6;
+}
+
+void ReplayBenchmark::printSummary() const
+{
+    const double wallSeconds = m_wallTime * 1E-9;
+    qInfo("Replayed %lld statuses with %zu frames in %.2f s: %.1f frames/s", m_statusCount, m_frameTimes.size(),
+          wallSeconds, wallSeconds > 0 ? m_frameTimes.size() / wallSeconds : 0.0);
+    if (!m_frameTimes.empty()) {
+        std::vector<qint64> frameTimes = m_frameTimes;
+        qInfo("Frame latency: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms",
+              percentile(frameTimes, 0.5), percentile(frameTimes, 0.9), percentile(frameTimes, 0.99),
+              *std::max_element(frameTimes.begin(), frameTimes.end()) * 1E-6);
+    }
+    qInfo("CPU time: tracking %.2f s, strategy %.2f s, log reading %.2f s", m_trackingCpuTime * 1E-9,
+          m_strategyCpuTime * 1E-9, m_readCpuTime * 1E-9);
+}
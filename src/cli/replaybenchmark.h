@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef REPLAYBENCHMARK_H
+#define REPLAYBENCHMARK_H
+
+#include "core/timer.h"
+#include "protobuf/command.h"
+#include "protobuf/status.h"
+#include <QObject>
+#include <QString>
+#include <memory>
+#include <vector>
+
+class Processor;
+class Strategy;
+class StrategyGameControllerMediator;
+
+/*!
+ * \brief Runs the tracking and the autoref strategy on a recorded log as fast as possible
+ *
+ * The vision packets recorded with each world state are passed to a processor,
+ * which tracks them and passes its world states on to the strategy. Everything
+ * runs in the thread calling run. Game events are only sent to a game
+ * controller if its host is given, no other sockets are opened. The time of the
+ * processor and the strategy follows the recorded status times instead of the
+ * wall clock. Logs recorded without vision packets are passed to the strategy
+ * as they are.
+ */
+class ReplayBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! game events are passed on internally if gameControllerHost is empty
+    explicit ReplayBenchmark(const Command &loadCommand, const QString &gameControllerHost = QString(), QObject *parent = nullptr);
+    ~ReplayBenchmark() override;
+    ReplayBenchmark(const ReplayBenchmark&) = delete;
+    ReplayBenchmark& operator=(const ReplayBenchmark&) = delete;
+
+    //! replays the log from skipSeconds after its first status on
+    bool run(const QString &filename, double skipSeconds = 0);
+    QString errorMsg() const { return m_errorMsg; }
+    void printSummary() const;
+
+signals:
+    //! statuses created by the strategy
+    void gotStatus(const Status &status);
+
+private:
+    template<typename Reader> bool replay(Reader &logfile, qint64 skip);
+    void track(const Status &status);
+    void handleTrackedStatus(const Status &status);
+
+    Timer m_timer;
+    std::shared_ptr<StrategyGameControllerMediator> m_gameControllerConnection;
+    Strategy *m_strategy;
+    Processor *m_processor;
+    //! unset until the first world state decided whether the log can be tracked
+    int m_retrack = -1;
+    //! referee packets aren't recorded, thus the recorded game state is used
+    amun::GameState m_gameState;
+    bool m_hasGameState = false;
+    QString m_errorMsg;
+
+    std::vector<qint64> m_frameTimes;
+    qint64 m_statusCount = 0;
+    qint64 m_wallTime = 0;
+    qint64 m_strategyCpuTime = 0;
+    qint64 m_trackingCpuTime = 0;
+    qint64 m_readCpuTime = 0;
+};
+
+#endif // REPLAYBENCHMARK_H
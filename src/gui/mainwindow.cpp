@@ -26,19 +26,28 @@
 #include "infoboard.h"
 #include "seshat/logfilewriter.h"
 #include "robotselectionwidget.h"
+#include "amun/recordingfilter.h"
+#include "amun/statusbus.h"
 #include "widgets/refereestatuswidget.h"
+#include <QActionGroup>
 #include <QDateTime>
 #include <QFile>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QLabel>
 #include <QMetaType>
+#include <QSettings>
 #include <QThread>
+#include <QTimer>
+#include <algorithm>
 
 MainWindow::MainWindow(bool showInfoboard, QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow),
     m_logFile(NULL),
     m_logFileThread(NULL),
+    m_recordedBytesPerSecond(0),
+    m_logFileBytes(0),
     m_logStartTime(0)
 {
     qRegisterMetaType<SSL_Referee::Command>("SSL_Referee::Command");
@@ -97,19 +106,27 @@ MainWindow::MainWindow(bool showInfoboard, QWidget *parent) :
     connect(ui->actionShowOptions, &QAction::triggered, [=]() {
             ui->dockOptions->setVisible(!ui->dockOptions->isVisible());
     });
-
-    // setup data distribution
-    connect(this, SIGNAL(gotStatus(Status)), ui->field, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), m_plotter, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), m_infoboard, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), m_infoboard->field, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->visualization, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->debugTree, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->timing, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), m_refereeStatus, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->log, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->autoref, SLOT(handleStatus(Status)));
-    connect(this, SIGNAL(gotStatus(Status)), ui->options, SLOT(handleStatus(Status)));
+    setupRecordingProfiles();
+
+    // setup data distribution, each widget only receives the status fields it displays
+    m_statusBus = new StatusBus(nullptr, this);
+    m_statusBus->subscribe("field", StatusBus::All, ui->field, &FieldWidget::handleStatus);
+    m_statusBus->subscribe("plotter", StatusBus::WorldState, m_plotter, &BallSpeedPlotter::handleStatus);
+    m_statusBus->subscribe("infoboard", StatusBus::GameState | StatusBus::Debug, m_infoboard, &InfoBoard::handleStatus);
+    m_statusBus->subscribe("infoboard field", StatusBus::All, m_infoboard->field, &FieldWidget::handleStatus);
+    m_statusBus->subscribe("visualization", StatusBus::Debug, ui->visualization, &VisualizationWidget::handleStatus);
+    m_statusBus->subscribe("debug tree", StatusBus::Debug, ui->debugTree, &DebugTreeWidget::handleStatus);
+    m_statusBus->subscribe("timing", StatusBus::All, ui->timing, &TimingWidget::handleStatus);
+    m_statusBus->subscribe("rule timing", StatusBus::Debug, ui->ruleTiming, &RuleTimingWidget::handleStatus);
+    m_statusBus->subscribe("referee status", StatusBus::GameState, m_refereeStatus, &RefereeStatusWidget::handleStatus);
+    m_statusBus->subscribe("log", StatusBus::Debug, ui->log, &LogWidget::handleStatus);
+    m_statusBus->subscribe("autoref", StatusBus::StrategyAutoref, ui->autoref, &AutorefTeamWidget::handleStatus);
+    m_statusBus->subscribe("options", StatusBus::All, ui->options, &OptionsWidget::handleStatus);
+
+    // show the delivery statistics in the debug tree
+    QTimer *statusBusTimer = new QTimer(this);
+    connect(statusBusTimer, &QTimer::timeout, this, &MainWindow::publishStatusBusStatistics);
+    statusBusTimer->start(1000);
 
     // start amun
     connect(&m_amun, SIGNAL(gotStatus(Status)), SLOT(handleStatus(Status)));
@@ -176,23 +193,17 @@ void MainWindow::handleStatus(const Status &status)
         m_yellowTeamName = QString::fromStdString(teamYellow.name());
     }
 
-    // keep team configurations for the logfile
+    // keep team configurations for the logfile, they are only copied once recording starts
     if (status->has_team_yellow()) {
-        m_yellowTeam.CopyFrom(status->team_yellow());
+        m_yellowTeamStatus = status;
     }
     if (status->has_team_blue()) {
-        m_blueTeam.CopyFrom(status->team_blue());
+        m_blueTeamStatus = status;
     }
     m_lastTime = status->time();
 
     if (m_logStartTime != 0) {
-        qint64 timeDelta = m_lastTime - m_logStartTime;
-        const double dtime = timeDelta / 1E9;
-        QString logLabel = "Log time: " + QString("%1:%2").arg((int) dtime / 60)
-                .arg((int) dtime % 60, 2, 10, QChar('0'));
-        if (m_logTimeLabel->text() != logLabel) {
-            m_logTimeLabel->setText(logLabel);
-        }
+        updateLogLabel();
     }
 
     if (status->has_amun_state() && status->amun_state().has_port_bind_error()) {
@@ -201,7 +212,38 @@ void MainWindow::handleStatus(const Status &status)
         statusBar()->addPermanentWidget(label);
     }
 
-    emit gotStatus(status);
+    m_statusBus->publish(status);
+}
+
+void MainWindow::updateLogLabel()
+{
+    qint64 timeDelta = m_lastTime - m_logStartTime;
+    const double dtime = timeDelta / 1E9;
+    QString logLabel = "Log time: " + QString("%1:%2").arg((int) dtime / 60)
+            .arg((int) dtime % 60, 2, 10, QChar('0'))
+            + QString(" (%1 kB/s)").arg(m_recordedBytesPerSecond / 1000, 0, 'f', 1);
+    if (m_logTimeLabel->text() != logLabel) {
+        m_logTimeLabel->setText(logLabel);
+    }
+}
+
+void MainWindow::publishStatusBusStatistics()
+{
+    // the timer runs once per second
+    if (m_logFile) {
+        // the growth of the log file, the statuses are only serialized by the writer
+        const qint64 size = QFileInfo(m_logFilename).size();
+        m_recordedBytesPerSecond = std::max<qint64>(size - m_logFileBytes, 0);
+        m_logFileBytes = std::max(size, m_logFileBytes);
+        updateLogLabel();
+    }
+
+    Status status(new amun::Status);
+    status->set_time(m_lastTime);
+    amun::DebugValues *debug = status->add_debug();
+    debug->set_source(amun::Controller);
+    m_statusBus->addToDebugValues(debug);
+    m_statusBus->publish(status);
 }
 
 void MainWindow::sendCommand(const Command &command)
@@ -245,7 +287,15 @@ void MainWindow::setRecording(bool record)
             delete m_logFile;
             return;
         }
-        connect(this, SIGNAL(gotStatus(Status)), m_logFile, SLOT(writeStatus(Status)));
+        const QString profile = m_recordingProfiles->checkedAction()->data().toString();
+        RecordingFilter::Profile recordingProfile = RecordingFilter::Profile::Full;
+        double debugRate = 0;
+        RecordingFilter::parse(profile, recordingProfile, debugRate);
+        m_recordingFilter.reset(new RecordingFilter(recordingProfile, debugRate));
+        m_recordedBytesPerSecond = 0;
+        m_logFilename = filename;
+        m_logFileBytes = 0;
+        m_statusBus->subscribe("log file", StatusBus::All, this, &MainWindow::recordStatus);
 
         // create thread if not done yet and move to seperate thread
         if (m_logFileThread == NULL) {
@@ -257,13 +307,19 @@ void MainWindow::setRecording(bool record)
         // add the current team settings to the logfile
         Status status(new amun::Status);
         status->set_time(m_lastTime);
-        status->mutable_team_yellow()->CopyFrom(m_yellowTeam);
-        status->mutable_team_blue()->CopyFrom(m_blueTeam);
+        if (m_yellowTeamStatus) {
+            status->mutable_team_yellow()->CopyFrom(m_yellowTeamStatus->team_yellow());
+        }
+        if (m_blueTeamStatus) {
+            status->mutable_team_blue()->CopyFrom(m_blueTeamStatus->team_blue());
+        }
         m_logFile->writeStatus(status);
         m_logStartTime = m_lastTime;
         m_logTimeLabel->show();
     } else {
         // defer log file deletion to happen in its thread
+        m_statusBus->unsubscribe(this);
+        m_recordingFilter.reset();
         m_logFile->deleteLater();
         m_logFile = NULL;
         m_logStartTime = 0;
@@ -272,6 +328,45 @@ void MainWindow::setRecording(bool record)
     }
 }
 
+void MainWindow::recordStatus(const Status &status)
+{
+    // filter before the status is serialized in the log file thread
+    const Status recorded = m_recordingFilter->filter(status);
+    if (recorded) {
+        QMetaObject::invokeMethod(m_logFile, "writeStatus", Qt::QueuedConnection, Q_ARG(Status, recorded));
+    }
+}
+
+void MainWindow::setupRecordingProfiles()
+{
+    QMenu *menu = ui->menuVideo->addMenu("Recording profile");
+    m_recordingProfiles = new QActionGroup(this);
+    const QList<QPair<QString, QString>> profiles = {
+        { "Full debug", "full" },
+        { "Decisions only", "decisions" },
+        { "Debug at 10 Hz", "debug:10" },
+        { "Debug at 1 Hz", "debug:1" }
+    };
+
+    QSettings s;
+    const QString selected = s.value("Logging/RecordingProfile", "full").toString();
+    for (const auto &profile : profiles) {
+        QAction *action = menu->addAction(profile.first);
+        action->setCheckable(true);
+        action->setData(profile.second);
+        action->setChecked(profile.second == selected);
+        m_recordingProfiles->addAction(action);
+    }
+    if (!m_recordingProfiles->checkedAction()) {
+        m_recordingProfiles->actions().first()->setChecked(true);
+    }
+
+    connect(m_recordingProfiles, &QActionGroup::triggered, [](QAction *action) {
+        QSettings s;
+        s.setValue("Logging/RecordingProfile", action->data());
+    });
+}
+
 void MainWindow::showConfigDialog()
 {
     m_configDialog->exec();
@@ -22,15 +22,19 @@
 #define MAINWINDOW_H
 
 #include "amun/amunclient.h"
-#include "protobuf/robot.pb.h"
+#include "protobuf/status.h"
 #include <QMainWindow>
 #include <QSet>
+#include <memory>
 
 class BallSpeedPlotter;
 class InfoBoard;
 class ConfigDialog;
 class LogFileWriter;
+class RecordingFilter;
 class RefereeStatusWidget;
+class StatusBus;
+class QActionGroup;
 class QLabel;
 class QModelIndex;
 class QThread;
@@ -46,9 +50,6 @@ public:
     explicit MainWindow(bool showInfoboard, QWidget *parent = 0);
     ~MainWindow() override;
 
-signals:
-    void gotStatus(const Status &status);
-
 protected:
     void closeEvent(QCloseEvent *e) override;
 
@@ -56,7 +57,13 @@ private slots:
     void handleStatus(const Status &status);
     void sendCommand(const Command &command);
     void setRecording(bool record);
+    void recordStatus(const Status &status);
     void showConfigDialog();
+    void publishStatusBusStatistics();
+
+private:
+    void setupRecordingProfiles();
+    void updateLogLabel();
 
 private:
     Ui::MainWindow *ui;
@@ -65,14 +72,20 @@ private:
     AmunClient m_amun;
     RefereeStatusWidget *m_refereeStatus;
     ConfigDialog *m_configDialog;
+    StatusBus *m_statusBus;
 
     LogFileWriter *m_logFile;
     QThread *m_logFileThread;
+    QActionGroup *m_recordingProfiles;
+    std::unique_ptr<RecordingFilter> m_recordingFilter;
+    double m_recordedBytesPerSecond;
+    QString m_logFilename;
+    qint64 m_logFileBytes;
     qint64 m_lastTime;
     QLabel *m_logTimeLabel;
     qint64 m_logStartTime;
-    robot::Team m_yellowTeam;
-    robot::Team m_blueTeam;
+    Status m_yellowTeamStatus;
+    Status m_blueTeamStatus;
     QString m_yellowTeamName;
     QString m_blueTeamName;
 };
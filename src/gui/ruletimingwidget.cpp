@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "ruletimingwidget.h"
+#include <QHeaderView>
+
+// minimum time between two updates of the displayed values
+static const qint64 UPDATE_INTERVAL = 500; // ms
+
+RuleTimingWidget::RuleTimingWidget(QWidget *parent) :
+    QTreeWidget(parent)
+{
+    setRootIsDecorated(false);
+    setSortingEnabled(true);
+    setHeaderLabels({"Rule", "Calls", "Mean [ms]", "Max [ms]", "Total [ms]", "Allocated [kB/call]"});
+    header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    sortByColumn(4, Qt::DescendingOrder);
+    m_updateTimer.start();
+}
+
+void RuleTimingWidget::handleStatus(const Status &status)
+{
+    updateRuleProfiles(status, m_profiles);
+
+    // don't consume cpu while hidden
+    if (isVisible() && m_updateTimer.hasExpired(UPDATE_INTERVAL)) {
+        m_updateTimer.restart();
+        updateItems();
+    }
+}
+
+void RuleTimingWidget::updateItems()
+{
+    setSortingEnabled(false);
+    for (const auto &[name, profile] : m_profiles) {
+        const QString rule = QString::fromStdString(name);
+        QTreeWidgetItem *&item = m_items[rule];
+        if (!item) {
+            item = new QTreeWidgetItem(this);
+            item->setText(0, rule);
+            for (int column = 1; column < columnCount(); column++) {
+                item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+            }
+        }
+        // numbers in the display role are sorted numerically
+        item->setData(1, Qt::DisplayRole, qint64(profile.calls));
+        item->setData(2, Qt::DisplayRole, profile.mean);
+        item->setData(3, Qt::DisplayRole, profile.max);
+        item->setData(4, Qt::DisplayRole, profile.total);
+        item->setData(5, Qt::DisplayRole, profile.calls > 0 ? profile.allocated / profile.calls / 1024 : 0.f);
+    }
+    setSortingEnabled(true);
+}
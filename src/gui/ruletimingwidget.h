@@ -0,0 +1,51 @@
+/***************************************************************************
+ *   Copyright 2026 Robotics Erlangen e.V.                                 *
+ *   http://www.robotics-erlangen.de/                                      *
+ *   info@robotics-erlangen.de                                             *
+ *                                                                         *
+ *   This program is free software: you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation, either version 3 of the License, or     *
+ *   any later version.                                                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef RULETIMINGWIDGET_H
+#define RULETIMINGWIDGET_H
+
+#include "amun/ruleprofile.h"
+#include "protobuf/status.h"
+#include <QElapsedTimer>
+#include <QMap>
+#include <QTreeWidget>
+
+/*!
+ * \brief Shows the per rule profile published by the autoref below "Rule profile"
+ */
+class RuleTimingWidget : public QTreeWidget
+{
+    Q_OBJECT
+
+public:
+    explicit RuleTimingWidget(QWidget *parent = nullptr);
+
+public slots:
+    void handleStatus(const Status &status);
+
+private:
+    void updateItems();
+
+    std::map<std::string, RuleProfile> m_profiles;
+    QMap<QString, QTreeWidgetItem*> m_items;
+    QElapsedTimer m_updateTimer;
+};
+
+#endif // RULETIMINGWIDGET_H